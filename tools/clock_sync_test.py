@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Run several native clock sync nodes (tools/native/clocksync) over loopback and check that they agree.
+
+Every node gets its own loopback address, a different clock start and optionally a clock
+drift, and renders the same effect. Reported:
+  clock spread  largest difference between the network clocks of the nodes, per report
+  frames        frames rendered by all nodes for the same effect time, and how many of
+                those had identical pixels on every node
+
+examples:
+  pio run -e native_clock
+  python3 tools/clock_sync_test.py .pio/build/native_clock/program --nodes 3 --seconds 10 --ppm 50
+"""
+import argparse
+import os
+import random
+import subprocess
+from collections import defaultdict
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("program", help="clock_node binary")
+    parser.add_argument("--nodes", type=int, default=3)
+    parser.add_argument("--seconds", type=float, default=10)
+    parser.add_argument("--ppm", type=float, default=0, help="maximum random clock drift per node")
+    parser.add_argument("--effect", type=int, default=9)
+    parser.add_argument("--leds", type=int, default=30)
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    rnd = random.Random(args.seed)
+    ips = [f"127.0.0.{i + 2}" for i in range(args.nodes)]
+    procs = []
+    for ip in ips:
+        env = dict(os.environ, WLED_NATIVE_IP=ip, WLED_NATIVE_PEERS=",".join(ips),
+                   WLED_NATIVE_CLOCK_OFFSET=str(rnd.randrange(0, 1000000)),
+                   WLED_NATIVE_CLOCK_PPM=str(rnd.uniform(-args.ppm, args.ppm)))
+        cmd = [args.program, "-s", str(args.seconds), "-e", str(args.effect), "-l", str(args.leds), "-f"]
+        procs.append(subprocess.Popen(cmd, env=env, stdout=subprocess.PIPE, text=True))
+
+    clocks = defaultdict(dict)  # report time -> node -> network - host clock (us), locked nodes only
+    frames = defaultdict(dict)  # effect time -> node -> checksum
+    for node, p in enumerate(procs):
+        out, _ = p.communicate()
+        for line in out.splitlines():
+            f = line.split()
+            if f[0] == "clock" and f[3] == "1":
+                clocks[int(f[1])][node] = int(f[4])
+            elif f[0] == "frame":
+                frames[int(f[1])][node] = f[2]
+        if p.returncode:
+            print(f"node {ips[node]} failed ({p.returncode})")
+            return 1
+
+    for t in sorted(clocks):
+        c = clocks[t]
+        spread = f"{max(c.values()) - min(c.values())} us" if len(c) == args.nodes else "-"
+        print(f"{t / 1000:5.1f} s  locked {len(c)}/{args.nodes}  clock spread {spread}")
+
+    common = [f for f in frames.values() if len(f) == args.nodes]
+    same = sum(1 for f in common if len(set(f.values())) == 1)
+    rendered = max(len([f for f in frames.values() if n in f]) for n in range(args.nodes))
+    print(f"frames  {len(common)} of {rendered} rendered by every node, {same} identical on all nodes")
+    return 0
+
+
+if __name__ == "__main__":
+    exit(main())
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""Convert WLED ledmaps between JSON (ledmapN.json) and the binary format (ledmapN.lmb).
+
+The binary format stores the map as runs of constant steps (rows, columns, serpentine
+segments, unused gaps) and literal entries, so large matrix maps become small files that
+WLED loads without parsing JSON. If both files exist WLED uses the binary one.
+Format (little endian, see WS2812FX::deserializeMap() in wled00/FX_fcn.cpp):
+  "WLM" 1, uint16 width, uint16 height, uint16 count, uint8 nameLen, name,
+  runs: uint16 h; h & 0x8000: (h & 0x7FFF) entries of uint16 start, int16 step
+                  else: h literal uint16 entries
+  0xFFFF (-1 in JSON) is an unused position
+
+examples:
+  python3 tools/ledmap_convert.py ledmap1.json                 writes ledmap1.lmb
+  python3 tools/ledmap_convert.py ledmap1.lmb -o check.json    back to JSON
+"""
+import argparse
+import json
+import os
+import struct
+import sys
+
+MAGIC = b"WLM\x01"
+MAX_RUN = 0x7FFF
+
+
+def to_index(v):
+    v = int(v)
+    return 0xFFFF if v < 0 or v > 16384 else v
+
+
+def encode(entries, width=0, height=0, name=""):
+    out = bytearray(MAGIC)
+    name = name.encode()[:255]
+    out += struct.pack("<HHHB", width, height, len(entries), len(name)) + name
+    i = 0
+    lit = []
+
+    def flush():
+        for k in range(0, len(lit), MAX_RUN):
+            chunk = lit[k:k + MAX_RUN]
+            out.extend(struct.pack("<H", len(chunk)) + struct.pack(f"<{len(chunk)}H", *chunk))
+        lit.clear()
+
+    while i < len(entries):
+        step = (entries[i + 1] - entries[i]) & 0xFFFF if i + 1 < len(entries) else 0
+        run = 1
+        while i + run < len(entries) and run < MAX_RUN and (entries[i + run] - entries[i + run - 1]) & 0xFFFF == step:
+            run += 1
+        if run >= 4:  # a step run takes 6 bytes, as much as 3 literal entries
+            flush()
+            out += struct.pack("<HHH", 0x8000 | run, entries[i], step)
+            i += run
+        else:
+            lit.append(entries[i])
+            i += 1
+    flush()
+    return bytes(out)
+
+
+def decode(data):
+    if data[:4] != MAGIC:
+        raise ValueError("not a binary ledmap")
+    width, height, count, name_len = struct.unpack_from("<HHHB", data, 4)
+    pos = 11
+    name = data[pos:pos + name_len].decode(errors="replace")
+    pos += name_len
+    entries = []
+    while len(entries) < count:
+        (h,) = struct.unpack_from("<H", data, pos)
+        pos += 2
+        run = h & MAX_RUN
+        if h & 0x8000:
+            v, step = struct.unpack_from("<HH", data, pos)
+            pos += 4
+            entries += [(v + k * step) & 0xFFFF for k in range(run)]
+        else:
+            entries += struct.unpack_from(f"<{run}H", data, pos)
+            pos += 2 * run
+    return entries[:count], width, height, name
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="ledmap .json or .lmb")
+    parser.add_argument("-o", "--output", help="output file (default: input with the other extension)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    binary = data[:4] == MAGIC
+    output = args.output or os.path.splitext(args.input)[0] + (".json" if binary else ".lmb")
+
+    if binary:
+        entries, width, height, name = decode(data)
+        doc = {}
+        if name:
+            doc["n"] = name
+        if width or height:
+            doc["width"], doc["height"] = width, height
+        doc["map"] = [-1 if v == 0xFFFF else v for v in entries]
+        with open(output, "w") as f:
+            json.dump(doc, f, separators=(",", ":"))
+        print(f"{args.input}: {len(entries)} entries -> {output}")
+        return 0
+
+    doc = json.loads(data)
+    entries = [to_index(v) for v in doc.get("map", [])]
+    if not entries:
+        print(f"{args.input}: no map", file=sys.stderr)
+        return 1
+    out = encode(entries, int(doc.get("width", 0)), int(doc.get("height", 0)), str(doc.get("n", "")))
+    if decode(out)[0] != entries:
+        raise AssertionError("round trip failed")
+    with open(output, "wb") as f:
+        f.write(out)
+    print(f"{args.input}: {len(entries)} entries, {len(data)} -> {len(out)} bytes -> {output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
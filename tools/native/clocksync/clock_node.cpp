@@ -0,0 +1,114 @@
+#include "wled.h"
+#include <chrono>
+#include <thread>
+
+/*
+ * Network clock sync node for the native (host) build.
+ *
+ * Runs WLED's main loop parts that take part in clock synchronisation (notifications,
+ * clock sync, effect rendering) on real UDP sockets, so several instances on one host
+ * synchronise over loopback. Start each one with its own address and clock:
+ *   WLED_NATIVE_IP=127.0.0.2 WLED_NATIVE_PEERS=127.0.0.2,127.0.0.3 WLED_NATIVE_CLOCK_OFFSET=5000 clock_node
+ * (tools/clock_sync_test.py does that for a group of nodes and evaluates their output).
+ *
+ * Printed once per report interval:
+ *   clock <ms since start> <master or "-"> <locked> <network clock - host clock (us)> <delay (us)> <error (us)>
+ * "network clock - host clock" compares against the host's monotonic clock, which all
+ * instances share: synchronised nodes print the same value.
+ * With -f every rendered frame is printed as
+ *   frame <effect time (strip.now)> <checksum of the pixels>
+ * so frames of different nodes can be matched by their effect time.
+ *
+ * usage: clock_node [-l leds] [-e effect] [-p priority] [-s seconds] [-r reportms] [-f]
+ */
+
+static const uint8_t nodePins[] = {2,4,5,12,13,14,15,16,17,18,19,21,22,23,25,26,27,32,33};
+static bool printFrames = false;
+
+static int64_t hostMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool setupStrip(unsigned leds) {
+  if (leds == 0 || leds > MAX_LEDS) return false;
+  BusManager::removeAll();
+  busConfigs.clear();
+  unsigned start = 0, n = 0;
+  while (start < leds && n < sizeof(nodePins)) {
+    uint8_t pins[OUTPUT_MAX_PINS] = {nodePins[n++]};
+    unsigned len = min(leds - start, (unsigned)MAX_LEDS_PER_BUS);
+    busConfigs.emplace_back(TYPE_WS2812_RGB, pins, start, len, COL_ORDER_GRB, false, 0, RGBW_MODE_MANUAL_ONLY, 0, useGlobalLedBuffer);
+    start += len;
+  }
+  strip.finalizeInit();
+  strip.makeAutoSegments(true);
+  return strip.getLengthTotal() >= leds;
+}
+
+// FNV-1a over the frame about to be shown
+static void onShow() {
+  if (!printFrames) return;
+  uint32_t h = 2166136261U;
+  for (unsigned i = 0; i < strip.getLengthTotal(); i++) {
+    uint32_t c = strip.getPixelColor(i);
+    for (int b = 0; b < 32; b += 8) h = (h ^ ((c >> b) & 0xFF)) * 16777619U;
+  }
+  printf("frame %lu %08x\n", (unsigned long)strip.now, (unsigned)h);
+}
+
+static void usage() {
+  fprintf(stderr, "usage: clock_node [-l leds] [-e effect] [-p priority] [-s seconds] [-r reportms] [-f]\n"
+                  "  -l  number of LEDs (default 30)\n"
+                  "  -e  effect id (default 9, rainbow, which only depends on the effect time)\n"
+                  "  -p  clock sync master priority, lowest wins (default 128)\n"
+                  "  -s  run time in seconds (default 10)\n"
+                  "  -r  report interval in ms (default 1000)\n"
+                  "  -f  print a checksum of every rendered frame\n");
+}
+
+int main(int argc, char **argv) {
+  unsigned leds = 30, effect = FX_MODE_RAINBOW_CYCLE, reportMs = 1000;
+  double seconds = 10;
+  clockSyncPriority = 128;
+
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    const char *v = (i + 1 < argc) ? argv[i + 1] : "";
+    if      (!strcmp(a, "-l")) { leds = atoi(v); i++; }
+    else if (!strcmp(a, "-e")) { effect = atoi(v); i++; }
+    else if (!strcmp(a, "-p")) { clockSyncPriority = atoi(v); i++; }
+    else if (!strcmp(a, "-s")) { seconds = atof(v); i++; }
+    else if (!strcmp(a, "-r")) { reportMs = max(1, atoi(v)); i++; }
+    else if (!strcmp(a, "-f")) printFrames = true;
+    else { usage(); return 1; }
+  }
+  if (!native::net().sockets) { fprintf(stderr, "set WLED_NATIVE_IP (and WLED_NATIVE_PEERS) to give the node an address\n"); return 1; }
+
+  setvbuf(stdout, nullptr, _IOLBF, 0);
+  pDoc = new PSRAMDynamicJsonDocument(JSON_BUFFER_SIZE);
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal);
+  if (!setupStrip(leds)) { fprintf(stderr, "cannot set up %u LEDs\n", leds); return 1; }
+  strip.setShowCallback(onShow);
+  strip.getMainSegment().setMode(effect);
+  interfacesInited = true;
+  udpConnected  = notifierUdp.begin(udpPort);
+  udp2Connected = notifier2Udp.begin(udpPort2);
+  if (!udpConnected || !udp2Connected) { fprintf(stderr, "cannot open UDP ports %u/%u on %s\n", udpPort, udpPort2, native::net().ip.toString().c_str()); return 1; }
+  clockSync = true;
+
+  const unsigned long start = millis();
+  unsigned long lastReport = start;
+  while (millis() - start < seconds * 1000) {
+    handleNotifications();
+    handleClockSync();
+    strip.service();
+    if (millis() - lastReport >= reportMs) {
+      lastReport = millis();
+      const clock_sync_status_t &cs = getClockSyncStatus();
+      printf("clock %lu %s %d %lld %u %d\n", lastReport - start, cs.master[0] ? cs.master.toString().c_str() : "-", cs.locked,
+             (long long)(networkMicros() - hostMicros()), (unsigned)cs.delay, (int)cs.error);
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(200)); // main loop period
+  }
+  return 0;
+}
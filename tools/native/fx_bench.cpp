@@ -0,0 +1,218 @@
+#include "wled.h"
+#include <chrono>
+#include <string>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/*
+ * Effect benchmark for the native (host) build.
+ *
+ * Drives WS2812FX::service() for every registered effect on a set of 1D strip
+ * lengths and 2D matrix sizes and reports, per effect:
+ *   fps      - frames per second the host computes (effect + transition + show)
+ *   ns/px    - wall time per frame divided by the number of pixels
+ *   segdata  - bytes of segment data the effect allocated (SEGENV.allocateData())
+ *   heap     - additional heap in use after the warm-up frames (glibc only)
+ *
+ * With -t every effect is measured while fading in from the previously measured one,
+ * i.e. both effects are rendered and crossfaded every frame.
+ *
+ * With -p no effects are run; instead the 2D particle system collision detection and
+ * move/force kernels are timed for the given particle counts (see ps_bench.cpp).
+ *
+ * Time is simulated: every frame advances millis() by one nominal frame time so
+ * effects evolve exactly as they would on a device, regardless of host speed.
+ *
+ * usage: fx_bench [-l 30,300,1000] [-m 16x16,32x32] [-f frames] [-w warmup] [-e id[,id...]] [-b] [-t] [-p 256,512,...] [-c]
+ */
+
+struct Layout {
+  unsigned width;
+  unsigned height;  // 1 for a 1D strip
+  bool     matrix;
+};
+
+int psCollisionBench(const std::vector<unsigned> &counts, unsigned passes, bool csv); // ps_bench.cpp
+
+static const uint8_t benchPins[] = {2,4,5,12,13,14,15,16,17,18,19,21,22,23,25,26,27,32,33};
+
+static size_t heapInUse() {
+#ifdef __GLIBC__
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+// (re)create buses and segments for the requested layout, exactly like a settings change on the device does
+static bool setupLayout(const Layout &l) {
+  unsigned total = l.width * l.height;
+  if (total == 0 || total > MAX_LEDS) return false;
+
+  BusManager::removeAll();
+  busConfigs.clear();
+  unsigned start = 0, n = 0;
+  while (start < total && n < sizeof(benchPins)) {
+    uint8_t pins[OUTPUT_MAX_PINS] = {benchPins[n++]};
+    unsigned len = min(total - start, (unsigned)MAX_LEDS_PER_BUS);
+    busConfigs.emplace_back(TYPE_WS2812_RGB, pins, start, len, COL_ORDER_GRB, false, 0, RGBW_MODE_MANUAL_ONLY, 0, useGlobalLedBuffer);
+    start += len;
+  }
+
+#ifndef WLED_DISABLE_2D
+  strip.isMatrix = l.matrix;
+  strip.panel.clear();
+  if (l.matrix) {
+    // Panel dimensions are 8 bit; tile larger matrices
+    for (unsigned y = 0; y < l.height; y += 128) for (unsigned x = 0; x < l.width; x += 128) {
+      WS2812FX::Panel p;
+      p.xOffset = x;
+      p.yOffset = y;
+      p.width   = min(l.width - x, 128U);
+      p.height  = min(l.height - y, 128U);
+      strip.panel.push_back(p);
+    }
+    strip.panels = strip.panel.size();
+  }
+#else
+  if (l.matrix) return false;
+#endif
+
+  strip.finalizeInit(); // creates buses and sets up the 2D mapping
+  strip.makeAutoSegments(true);
+  strip.setBrightness(255, true);
+  strip.setTransition(0);
+  return strip.getLengthTotal() >= total && strip.isMatrix == l.matrix;
+}
+
+static std::vector<unsigned> parseList(const char *arg) {
+  std::vector<unsigned> out;
+  for (const char *p = arg; *p; ) {
+    char *end;
+    unsigned long v = strtoul(p, &end, 10);
+    if (end == p) break;
+    out.push_back(v);
+    p = (*end == ',') ? end + 1 : end;
+  }
+  return out;
+}
+
+static std::vector<Layout> parseSizes(const char *arg) {
+  std::vector<Layout> out;
+  for (const char *p = arg; *p; ) {
+    unsigned w, h;
+    int used = 0;
+    if (sscanf(p, "%ux%u%n", &w, &h, &used) != 2) break;
+    out.push_back({w, h, true});
+    p += used;
+    if (*p == ',') p++;
+  }
+  return out;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: fx_bench [-l lengths] [-m WxH,...] [-f frames] [-w warmup] [-e ids] [-b] [-t] [-p counts] [-c]\n"
+                  "  -l  comma separated 1D strip lengths (default 30,300,1000)\n"
+                  "  -m  comma separated 2D matrix sizes (default 16x16,32x32)\n"
+                  "  -f  timed frames per effect (default 500)\n"
+                  "  -w  untimed warm-up frames per effect (default 20)\n"
+                  "  -e  only run the listed effect ids\n"
+                  "  -b  render into segment buffers and composite (useSegmentBuffers)\n"
+                  "  -t  measure during a fade transition from the previous effect\n"
+                  "  -p  time 2D particle collisions and kernels for the listed particle counts (64x64, -f passes)\n"
+                  "  -c  CSV output\n");
+}
+
+int main(int argc, char **argv) {
+  std::vector<Layout> layouts;
+  std::vector<unsigned> lengths = {30, 300, 1000};
+  std::vector<Layout> matrices = {{16, 16, true}, {32, 32, true}};
+  std::vector<unsigned> only;
+  std::vector<unsigned> particles;
+  unsigned frames = 500, warmup = 20;
+  bool csv = false;
+  bool fade = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    const char *v = (i + 1 < argc) ? argv[i + 1] : "";
+    if      (!strcmp(a, "-l")) { lengths  = parseList(v);  i++; }
+    else if (!strcmp(a, "-m")) { matrices = parseSizes(v); i++; }
+    else if (!strcmp(a, "-f")) { frames   = max(1, atoi(v)); i++; }
+    else if (!strcmp(a, "-w")) { warmup   = max(0, atoi(v)); i++; }
+    else if (!strcmp(a, "-e")) { only     = parseList(v);  i++; }
+    else if (!strcmp(a, "-b")) { useSegmentBuffers = true; }
+    else if (!strcmp(a, "-t")) { fade = true; }
+    else if (!strcmp(a, "-p")) { particles = parseList(v); i++; }
+    else if (!strcmp(a, "-c")) { csv = true; }
+    else { usage(); return 1; }
+  }
+  for (unsigned len : lengths) layouts.push_back({len, 1, false});
+  for (const Layout &m : matrices) layouts.push_back(m);
+
+  pDoc = new PSRAMDynamicJsonDocument(JSON_BUFFER_SIZE);
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // done by deserializeConfig() on the device
+  native::useManualClock();
+  const unsigned frameMs = FRAMETIME_FIXED;
+
+  if (!particles.empty()) {
+    if (!setupLayout({64, 64, true})) return 1;
+    return psCollisionBench(particles, frames, csv);
+  }
+
+  if (csv) printf("layout,id,effect,fps,ns_per_px,segdata,heap\n");
+  for (const Layout &l : layouts) {
+    char layoutName[24];
+    if (l.matrix) snprintf(layoutName, sizeof(layoutName), "%ux%u", l.width, l.height);
+    else          snprintf(layoutName, sizeof(layoutName), "%u", l.width);
+    if (!setupLayout(l)) {
+      fprintf(stderr, "skipping layout %s (exceeds %u LEDs or invalid)\n", layoutName, (unsigned)MAX_LEDS);
+      continue;
+    }
+    const unsigned pixels = l.width * l.height;
+    if (!csv) printf("\n%s (%u px, %u frames)\n%-4s %-28s %10s %10s %8s %8s\n", layoutName, pixels, frames, "id", "effect", "fps", "ns/px", "segdata", "heap");
+
+    unsigned prevMode = 0;
+    for (unsigned m = 0; m < strip.getModeCount(); m++) {
+      if (!only.empty() && std::find(only.begin(), only.end(), m) == only.end()) continue;
+      if (strncmp_P(strip.getModeData(m), PSTR("RSVD"), 4) == 0) continue;
+      char name[64];
+      extractModeName(m, nullptr, name, sizeof(name) - 1);
+
+      Segment &seg = strip.getMainSegment();
+      if (fade) {
+        // let previous effect run, then fade into this one for the rest of the measurement
+        seg.setMode(prevMode, true);
+        for (unsigned i = 0; i < warmup + 2; i++) { native::advanceClock(frameMs); strip.trigger(); strip.service(); }
+        strip.setTransition(min((warmup + frames + 2) * frameMs + 1000, 65535U));
+      } else {
+        seg.setMode(0);               // always start from a fresh effect state
+        for (unsigned i = 0; i < 2; i++) { native::advanceClock(frameMs); strip.trigger(); strip.service(); }
+        seg.deallocateData();         // so segdata reflects this effect only
+      }
+      prevMode = m;
+      size_t heapBefore = heapInUse();
+      seg.setMode(m, true);           // load effect defaults like the UI does
+      for (unsigned i = 0; i < warmup; i++) { native::advanceClock(frameMs); strip.trigger(); strip.service(); }
+      size_t heapAfter = heapInUse();
+
+      auto t0 = std::chrono::steady_clock::now();
+      for (unsigned i = 0; i < frames; i++) {
+        native::advanceClock(frameMs);
+        strip.trigger();
+        strip.service();
+      }
+      double ns  = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+      if (fade) { strip.setTransition(0); seg.stopTransition(); }
+      double fps = frames * 1e9 / ns;
+      double nsPerPx = ns / frames / pixels;
+      long heap = heapAfter > heapBefore ? long(heapAfter - heapBefore) : 0;
+
+      if (csv) printf("%s,%u,\"%s\",%.1f,%.2f,%u,%ld\n", layoutName, m, name, fps, nsPerPx, Segment::getUsedSegmentData(), heap);
+      else     printf("%-4u %-28s %10.1f %10.2f %8u %8ld\n", m, name, fps, nsPerPx, Segment::getUsedSegmentData(), heap);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,467 @@
+#pragma once
+/*
+ * Host (native) stand-in for the Arduino-ESP32 core.
+ *
+ * Provides just enough of the Arduino/ESP-IDF API for the effect engine, bus manager
+ * and their direct dependencies to compile and run on a PC (see tools/native/README.md).
+ * The native build impersonates a classic ESP32 (ARDUINO_ARCH_ESP32 is defined) so the
+ * code paths exercised are the same ones that run on the most common target.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <limits.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+typedef uint16_t word;
+inline uint16_t makeWord(uint16_t w)         { return w; }
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (uint16_t(h) << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+using std::min;
+using std::max;
+
+// ---------------------------------------------------------------------------
+// PROGMEM: flash and RAM share one address space on the host
+// ---------------------------------------------------------------------------
+class __FlashStringHelper;
+#define PROGMEM
+#define PGM_P               const char *
+#define PSTR(s)             (s)
+#define F(s)                (reinterpret_cast<const __FlashStringHelper *>(s))
+#define FPSTR(p)            (reinterpret_cast<const __FlashStringHelper *>(p))
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr)  (*(void * const *)(addr))
+// pointer tables are read with pgm_read_dword() on 32 bit MCUs; keep the pointee type so pointers are not truncated on 64 bit hosts
+template<typename T> inline T pgm_read_dword_native(const T *addr) { return *addr; }
+inline uint32_t pgm_read_dword_native(const void *addr) { return *(const uint32_t *)addr; }
+#define pgm_read_dword(addr) pgm_read_dword_native(addr)
+#define memcpy_P    memcpy
+#define memcmp_P    memcmp
+#define strcpy_P    strcpy
+#define strncpy_P   strncpy
+#define strcat_P    strcat
+#define strncat_P   strncat
+#define strcmp_P    strcmp
+#define strncmp_P   strncmp
+#define strcasecmp_P strcasecmp
+#define strlen_P    strlen
+#define strstr_P    strstr
+#define strchr_P    strchr
+#define sprintf_P   sprintf
+#define snprintf_P  snprintf
+#define vsnprintf_P vsnprintf
+#define printf_P    printf
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) { size_t n = len < size - 1 ? len : size - 1; memcpy(dst, src, n); dst[n] = '\0'; }
+  return len;
+}
+inline size_t strlcat(char *dst, const char *src, size_t size) {
+  size_t dlen = strnlen(dst, size);
+  return dlen == size ? size + strlen(src) : dlen + strlcpy(dst + dlen, src, size - dlen);
+}
+#endif
+
+// memory placement attributes
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define ICACHE_RAM_ATTR
+
+// ---------------------------------------------------------------------------
+// time: wall clock, or a manually advanced clock for deterministic benchmarks
+// ---------------------------------------------------------------------------
+namespace native {
+  // $WLED_NATIVE_CLOCK_OFFSET (ms) starts the wall clock at that value instead of 0 and
+  // $WLED_NATIVE_CLOCK_PPM makes it run fast or slow, to give instances distinct clocks
+  struct Clock {
+    bool     manual = false;
+    uint64_t manualUs = 0;
+    uint64_t offsetUs = getenv("WLED_NATIVE_CLOCK_OFFSET") ? strtoull(getenv("WLED_NATIVE_CLOCK_OFFSET"), nullptr, 10) * 1000 : 0;
+    double   rate     = getenv("WLED_NATIVE_CLOCK_PPM") ? 1.0 + atof(getenv("WLED_NATIVE_CLOCK_PPM")) / 1e6 : 1.0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  };
+  inline Clock &clock() { static Clock c; return c; }
+  inline uint64_t wallMicros() {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - clock().start).count();
+    return clock().offsetUs + uint64_t(us * clock().rate);
+  }
+  // freeze time at the current value; from then on only advanceClock() moves millis()/micros()
+  inline void useManualClock(bool on = true) { clock().manualUs = wallMicros(); clock().manual = on; }
+  inline void advanceClock(uint32_t ms)      { clock().manualUs += uint64_t(ms) * 1000; }
+}
+
+inline unsigned long micros()                    { return native::clock().manual ? native::clock().manualUs : native::wallMicros(); }
+inline unsigned long millis()                    { return micros() / 1000; }
+inline int64_t       esp_timer_get_time()        { return micros(); }
+inline void          yield()                     {}
+inline void          delayMicroseconds(unsigned) {}
+inline void          delay(unsigned long ms)     { if (native::clock().manual) native::advanceClock(ms); }
+
+// ---------------------------------------------------------------------------
+// math and bit helpers
+// ---------------------------------------------------------------------------
+#ifndef M_TWOPI
+#define M_TWOPI    6.283185307179586476925286766559
+#endif
+#ifndef PI
+#define PI         3.1415926535897932384626433832795
+#endif
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x)        ((x)*(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define _min(a,b)    ((a)<(b)?(a):(b))
+#define _max(a,b)    ((a)>(b)?(a):(b))
+#define lowByte(w)   ((uint8_t) ((w) & 0xff))
+#define highByte(w)  ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit)  (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)   ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b)       (1UL << (b))
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  if (in_max == in_min) return out_min;
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// hardware RNG replacement (xorshift32, fixed seed so benchmark runs are repeatable)
+inline uint32_t &native_rng_state() { static uint32_t s = 0x2545F491; return s; }
+inline uint32_t esp_random() {
+  uint32_t &x = native_rng_state();
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  return x;
+}
+inline void randomSeed(unsigned long seed) { if (seed) native_rng_state() = seed; }
+inline long random(long howbig)            { return howbig <= 0 ? 0 : esp_random() % howbig; }
+inline long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+
+// ---------------------------------------------------------------------------
+// GPIO (no hardware; all calls are no-ops)
+// ---------------------------------------------------------------------------
+#define LOW               0x0
+#define HIGH              0x1
+#define INPUT             0x01
+#define OUTPUT            0x03
+#define PULLUP            0x04
+#define INPUT_PULLUP      0x05
+#define PULLDOWN          0x08
+#define INPUT_PULLDOWN    0x09
+#define OPEN_DRAIN        0x10
+#define OUTPUT_OPEN_DRAIN 0x12
+#define GPIO_PIN_COUNT    40
+#define NOT_A_PIN         -1
+
+inline void pinMode(uint8_t, uint8_t)         {}
+inline void digitalWrite(uint8_t, uint8_t)    {}
+inline int  digitalRead(uint8_t)              { return LOW; }
+inline int  analogRead(uint8_t)               { return 0; }
+inline void analogWrite(uint8_t, int)         {}
+inline bool digitalPinIsValid(int pin)        { return pin >= 0 && pin < GPIO_PIN_COUNT && (pin < 6 || pin > 11); }
+inline bool digitalPinCanOutput(int pin)      { return digitalPinIsValid(pin) && pin < 34; }
+
+// LEDC (PWM) HAL
+inline double ledcSetup(uint8_t, double freq, uint8_t) { return freq; }
+inline void   ledcAttachPin(uint8_t, uint8_t)          {}
+inline void   ledcDetachPin(uint8_t)                   {}
+inline void   ledcWrite(uint8_t, uint32_t)             {}
+
+// ---------------------------------------------------------------------------
+// memory
+// ---------------------------------------------------------------------------
+inline bool  psramFound()                        { return false; }
+inline void *ps_malloc(size_t size)              { return malloc(size); }
+inline void *ps_calloc(size_t n, size_t size)    { return calloc(n, size); }
+inline void *ps_realloc(void *ptr, size_t size)  { return realloc(ptr, size); }
+
+// ---------------------------------------------------------------------------
+// FreeRTOS (single threaded host: locks always succeed)
+// ---------------------------------------------------------------------------
+typedef void *   SemaphoreHandle_t;
+typedef void *   xSemaphoreHandle;
+typedef void *   TaskHandle_t;
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+#define pdFALSE          0
+#define pdTRUE           1
+#define pdPASS           pdTRUE
+#define pdFAIL           pdFALSE
+#define portMAX_DELAY    0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+inline SemaphoreHandle_t xSemaphoreCreateMutex()                          { return reinterpret_cast<SemaphoreHandle_t>(1); }
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex()                 { return reinterpret_cast<SemaphoreHandle_t>(1); }
+inline BaseType_t        xSemaphoreTake(SemaphoreHandle_t, TickType_t)    { return pdTRUE; }
+inline BaseType_t        xSemaphoreGive(SemaphoreHandle_t)                { return pdTRUE; }
+inline BaseType_t        xSemaphoreTakeRecursive(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t        xSemaphoreGiveRecursive(SemaphoreHandle_t)       { return pdTRUE; }
+inline void              vTaskDelay(TickType_t ticks)                     { delay(ticks); }
+
+// ---------------------------------------------------------------------------
+// String
+// ---------------------------------------------------------------------------
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class String {
+  private:
+    std::string _s;
+
+    static std::string fromNumber(unsigned long long v, unsigned base, bool neg = false) {
+      if (base < 2 || base > 16) base = 10;
+      char buf[66]; char *p = buf + sizeof(buf) - 1; *p = '\0';
+      do { unsigned d = v % base; *--p = char(d < 10 ? '0' + d : 'a' + d - 10); v /= base; } while (v);
+      if (neg) *--p = '-';
+      return std::string(p);
+    }
+
+  public:
+    String(const char *cstr = "")              : _s(cstr ? cstr : "") {}
+    String(const char *cstr, size_t len)       : _s(cstr ? cstr : "", cstr ? len : 0) {}
+    String(const __FlashStringHelper *str)     : _s(str ? reinterpret_cast<const char *>(str) : "") {}
+    String(const std::string &s)               : _s(s) {}
+    String(const String &) = default;
+    String(String &&) = default;
+    explicit String(char c)                    : _s(1, c) {}
+    explicit String(unsigned char v, unsigned char base = 10) : _s(fromNumber(v, base)) {}
+    explicit String(int v, unsigned char base = 10)           : _s(base == 10 && v < 0 ? fromNumber(-(long long)v, 10, true) : fromNumber((unsigned)v, base)) {}
+    explicit String(unsigned v, unsigned char base = 10)      : _s(fromNumber(v, base)) {}
+    explicit String(long v, unsigned char base = 10)          : _s(base == 10 && v < 0 ? fromNumber(-(long long)v, 10, true) : fromNumber((unsigned long)v, base)) {}
+    explicit String(unsigned long v, unsigned char base = 10) : _s(fromNumber(v, base)) {}
+    explicit String(float v, unsigned char decimals = 2)      { char b[48]; snprintf(b, sizeof(b), "%.*f", decimals, (double)v); _s = b; }
+    explicit String(double v, unsigned char decimals = 2)     { char b[48]; snprintf(b, sizeof(b), "%.*f", decimals, v); _s = b; }
+
+    String &operator=(const String &) = default;
+    String &operator=(String &&) = default;
+    String &operator=(const char *cstr) { _s = cstr ? cstr : ""; return *this; }
+    String &operator=(const __FlashStringHelper *str) { _s = str ? reinterpret_cast<const char *>(str) : ""; return *this; }
+
+    const char *c_str() const           { return _s.c_str(); }
+    unsigned    length() const          { return _s.length(); }
+    bool        isEmpty() const         { return _s.empty(); }
+    bool        reserve(unsigned size)  { _s.reserve(size); return true; }
+    char        charAt(unsigned i) const { return i < _s.length() ? _s[i] : 0; }
+    char        operator[](unsigned i) const { return charAt(i); }
+    char       &operator[](unsigned i)  { return _s[i]; }
+    void        setCharAt(unsigned i, char c) { if (i < _s.length()) _s[i] = c; }
+    const std::string &str() const      { return _s; }
+
+    bool concat(const String &s)        { _s += s._s; return true; }
+    bool concat(const char *cstr)       { if (cstr) _s += cstr; return true; }
+    bool concat(const char *cstr, unsigned len) { if (cstr) _s.append(cstr, len); return true; }
+    bool concat(const __FlashStringHelper *str) { return concat(reinterpret_cast<const char *>(str)); }
+    bool concat(char c)                 { _s += c; return true; }
+    bool concat(unsigned char v)        { return concat(String(v)); }
+    bool concat(int v)                  { return concat(String(v)); }
+    bool concat(unsigned v)             { return concat(String(v)); }
+    bool concat(long v)                 { return concat(String(v)); }
+    bool concat(unsigned long v)        { return concat(String(v)); }
+    bool concat(float v)                { return concat(String(v)); }
+    bool concat(double v)               { return concat(String(v)); }
+    template<typename T> String &operator+=(const T &v) { concat(v); return *this; }
+    String &operator+=(const char *cstr) { concat(cstr); return *this; }
+
+    bool operator==(const String &o) const  { return _s == o._s; }
+    bool operator==(const char *cstr) const { return _s == (cstr ? cstr : ""); }
+    bool operator!=(const String &o) const  { return !(*this == o); }
+    bool operator!=(const char *cstr) const { return !(*this == cstr); }
+    bool operator<(const String &o) const   { return _s < o._s; }
+    bool equals(const String &o) const      { return *this == o; }
+    bool equalsIgnoreCase(const String &o) const { return strcasecmp(c_str(), o.c_str()) == 0; }
+    int  compareTo(const String &o) const   { return _s.compare(o._s); }
+
+    bool startsWith(const String &p) const  { return _s.compare(0, p._s.length(), p._s) == 0; }
+    bool endsWith(const String &p) const    { return _s.length() >= p._s.length() && _s.compare(_s.length() - p._s.length(), p._s.length(), p._s) == 0; }
+    int  indexOf(char c, unsigned from = 0) const           { auto p = _s.find(c, from); return p == std::string::npos ? -1 : int(p); }
+    int  indexOf(const String &s, unsigned from = 0) const  { auto p = _s.find(s._s, from); return p == std::string::npos ? -1 : int(p); }
+    int  lastIndexOf(char c) const                          { auto p = _s.rfind(c); return p == std::string::npos ? -1 : int(p); }
+    String substring(unsigned from) const                   { return from < _s.length() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const      { if (to < from) std::swap(from, to); return from < _s.length() ? String(_s.substr(from, to - from)) : String(); }
+    void replace(const String &f, const String &r)          { if (f._s.empty()) return; size_t p = 0; while ((p = _s.find(f._s, p)) != std::string::npos) { _s.replace(p, f._s.length(), r._s); p += r._s.length(); } }
+    void remove(unsigned index, unsigned count = (unsigned)-1) { if (index < _s.length()) _s.erase(index, count); }
+    void toLowerCase()                      { for (auto &c : _s) c = tolower(c); }
+    void toUpperCase()                      { for (auto &c : _s) c = toupper(c); }
+    void trim()                             { size_t b = _s.find_first_not_of(" \t\r\n"); size_t e = _s.find_last_not_of(" \t\r\n"); _s = b == std::string::npos ? "" : _s.substr(b, e - b + 1); }
+    long  toInt() const                     { return atol(c_str()); }
+    float toFloat() const                   { return atof(c_str()); }
+    void  toCharArray(char *buf, unsigned size, unsigned index = 0) const { if (!buf || !size) return; strncpy(buf, index < _s.length() ? _s.c_str() + index : "", size - 1); buf[size - 1] = '\0'; }
+    void  getBytes(unsigned char *buf, unsigned size, unsigned index = 0) const { toCharArray(reinterpret_cast<char *>(buf), size, index); }
+};
+
+template<typename T> inline String operator+(const String &a, const T &b) { String r(a); r += b; return r; }
+inline String operator+(const char *a, const String &b) { String r(a); r += b; return r; }
+
+class StringSumHelper : public String {
+  public:
+    using String::String;
+    StringSumHelper(const String &s) : String(s) {}
+};
+
+// ---------------------------------------------------------------------------
+// Print / Stream / Serial
+// ---------------------------------------------------------------------------
+class Print;
+class Printable {
+  public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) { size_t n = 0; while (size--) { if (!write(*buffer++)) break; n++; } return n; }
+    size_t write(const char *str)                 { return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+    virtual int  availableForWrite()              { return 0; }
+    virtual void flush()                          {}
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+      char buf[256];
+      va_list arg; va_start(arg, format);
+      int len = vsnprintf(buf, sizeof(buf), format, arg);
+      va_end(arg);
+      if (len < 0) return 0;
+      if ((size_t)len < sizeof(buf)) return write(buf, len);
+      std::string big(len + 1, '\0');
+      va_start(arg, format); vsnprintf(&big[0], big.size(), format, arg); va_end(arg);
+      return write(big.c_str(), len);
+    }
+    size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+    size_t print(const String &s)              { return write(s.c_str(), s.length()); }
+    size_t print(const char *s)                { return write(s); }
+    size_t print(char c)                       { return write(uint8_t(c)); }
+    size_t print(unsigned char v, int base = DEC) { return print(String(v, base)); }
+    size_t print(int v, int base = DEC)        { return print(String(v, base)); }
+    size_t print(unsigned v, int base = DEC)   { return print(String(v, base)); }
+    size_t print(long v, int base = DEC)       { return print(String(v, base)); }
+    size_t print(unsigned long v, int base = DEC) { return print(String(v, base)); }
+    size_t print(double v, int digits = 2)     { return print(String(v, digits)); }
+    size_t println()                           { return write("\r\n"); }
+    template<typename T> size_t println(const T &v)           { size_t n = print(v); return n + println(); }
+    template<typename T> size_t println(const T &v, int base) { size_t n = print(v, base); return n + println(); }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void   setTimeout(unsigned long) {}
+    size_t readBytes(char *buffer, size_t length) {
+      size_t n = 0;
+      while (n < length) { int c = read(); if (c < 0) break; buffer[n++] = char(c); }
+      return n;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes(reinterpret_cast<char *>(buffer), length); }
+    size_t readBytesUntil(char terminator, char *buffer, size_t length) {
+      size_t n = 0;
+      while (n < length) { int c = read(); if (c < 0 || c == terminator) break; buffer[n++] = char(c); }
+      return n;
+    }
+    size_t readBytesUntil(char terminator, uint8_t *buffer, size_t length) { return readBytesUntil(terminator, reinterpret_cast<char *>(buffer), length); }
+    bool find(const char *target) {
+      size_t len = strlen(target), idx = 0;
+      if (!len) return true;
+      int c;
+      while ((c = read()) >= 0) {
+        if (c == target[idx]) { if (++idx == len) return true; }
+        else idx = (c == target[0]) ? 1 : 0;
+      }
+      return false;
+    }
+    String readString()                { String s; int c; while ((c = read()) >= 0) s += char(c); return s; }
+    String readStringUntil(char t)     { String s; int c; while ((c = read()) >= 0 && c != t) s += char(c); return s; }
+};
+
+class HardwareSerial : public Stream {
+  public:
+    void   begin(unsigned long, uint32_t = 0, int8_t = -1, int8_t = -1) {}
+    void   end()                                  {}
+    size_t write(uint8_t c) override              { return fwrite(&c, 1, 1, stdout); }
+    size_t write(const uint8_t *b, size_t n) override { return fwrite(b, 1, n, stdout); }
+    using Print::write;
+    int    available() override                   { return 0; }
+    int    read() override                        { return -1; }
+    int    peek() override                        { return -1; }
+    void   flush() override                       { fflush(stdout); }
+    int    availableForWrite() override           { return 128; }
+    operator bool() const                         { return true; }
+};
+inline HardwareSerial Serial;
+
+// ---------------------------------------------------------------------------
+// IPAddress
+// ---------------------------------------------------------------------------
+class IPAddress {
+  private:
+    union { uint8_t bytes[4]; uint32_t dword; } _address;
+  public:
+    IPAddress()                                        { _address.dword = 0; }
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { _address.bytes[0] = a; _address.bytes[1] = b; _address.bytes[2] = c; _address.bytes[3] = d; }
+    IPAddress(uint32_t address)                        { _address.dword = address; }
+    operator uint32_t() const                          { return _address.dword; }
+    bool operator==(const IPAddress &o) const          { return _address.dword == o._address.dword; }
+    bool operator!=(const IPAddress &o) const          { return _address.dword != o._address.dword; }
+    uint8_t  operator[](int i) const                   { return _address.bytes[i]; }
+    uint8_t &operator[](int i)                         { return _address.bytes[i]; }
+    String toString() const { char b[16]; snprintf(b, sizeof(b), "%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]); return String(b); }
+    bool fromString(const char *s) {
+      unsigned a, b, c, d;
+      if (!s || sscanf(s, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255) return false;
+      *this = IPAddress(a, b, c, d);
+      return true;
+    }
+    bool fromString(const String &s) { return fromString(s.c_str()); }
+};
+#define INADDR_NONE IPAddress(0,0,0,0)
+
+// ---------------------------------------------------------------------------
+// ESP system object
+// ---------------------------------------------------------------------------
+class EspClass {
+  public:
+    // there is no meaningful free heap on a PC; report a fixed, ESP32-sized pool so allocation heuristics behave as on target
+    uint32_t    getFreeHeap()       { return 160000; }
+    uint32_t    getMinFreeHeap()    { return 160000; }
+    uint32_t    getMaxAllocHeap()   { return 110000; }
+    uint32_t    getHeapSize()       { return 320000; }
+    uint32_t    getPsramSize()      { return 0; }
+    uint32_t    getFreePsram()      { return 0; }
+    uint32_t    getFlashChipSize()  { return 4 * 1024 * 1024; }
+    uint32_t    getCpuFreqMHz()     { return 240; }
+    uint8_t     getChipRevision()   { return 3; }
+    const char *getChipModel()      { return "native"; }
+    uint64_t    getEfuseMac()       { return 0x0000AABBCCDDEEFFULL; }
+    const char *getSdkVersion()     { return "native"; }
+    void        restart()           { exit(0); }
+};
+inline EspClass ESP;
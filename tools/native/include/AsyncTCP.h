@@ -0,0 +1,9 @@
+#pragma once
+// host stand-in for AsyncTCP (declarations only)
+#include <Arduino.h>
+
+class AsyncClient {
+  public:
+    bool connected() const { return false; }
+    void close(bool = false) {}
+};
@@ -0,0 +1,30 @@
+#pragma once
+// host stand-in for the ESP32 AsyncUDP library (listeners never receive packets)
+#include <Arduino.h>
+
+class AsyncUDPPacket {
+  private:
+    uint8_t  *_data;
+    size_t    _len;
+    IPAddress _remoteIP;
+    uint16_t  _localPort;
+  public:
+    AsyncUDPPacket(uint8_t *data = nullptr, size_t len = 0, IPAddress remote = IPAddress(), uint16_t localPort = 0)
+    : _data(data), _len(len), _remoteIP(remote), _localPort(localPort) {}
+    uint8_t  *data()        { return _data; }
+    size_t    length()      { return _len; }
+    IPAddress remoteIP()    { return _remoteIP; }
+    uint16_t  localPort()   { return _localPort; }
+    bool      isBroadcast() { return false; }
+    bool      isMulticast() { return false; }
+};
+
+typedef std::function<void(AsyncUDPPacket &packet)> AuPacketHandlerFunction;
+
+class AsyncUDP {
+  public:
+    bool listen(uint16_t)                                  { return false; }
+    bool listenMulticast(const IPAddress &, uint16_t, uint8_t = 1) { return false; }
+    void onPacket(AuPacketHandlerFunction)                 {}
+    void close()                                           {}
+};
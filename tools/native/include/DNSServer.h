@@ -0,0 +1,11 @@
+#pragma once
+// host stand-in for DNSServer (captive portal is not emulated)
+#include <Arduino.h>
+
+class DNSServer {
+  public:
+    bool start(uint16_t, const String &, const IPAddress &) { return false; }
+    void stop() {}
+    void processNextRequest() {}
+    void setErrorReplyCode(uint8_t) {}
+};
@@ -0,0 +1,164 @@
+#pragma once
+// host stand-in for the (Aircoookie fork of) ESPAsyncWebServer: types only, no HTTP server is started
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <functional>
+
+static const char CONTENT_TYPE_JSON[] PROGMEM = "application/json";
+
+typedef uint8_t WebRequestMethodComposite;
+enum WebRequestMethod : WebRequestMethodComposite {
+  HTTP_GET     = 0b00000001,
+  HTTP_POST    = 0b00000010,
+  HTTP_DELETE  = 0b00000100,
+  HTTP_PUT     = 0b00001000,
+  HTTP_PATCH   = 0b00010000,
+  HTTP_HEAD    = 0b00100000,
+  HTTP_OPTIONS = 0b01000000,
+  HTTP_ANY     = 0b01111111,
+};
+
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+
+class AsyncWebServerRequest;
+class AsyncWebServerResponse {
+  protected:
+    int    _code = 0;
+    String _contentType;
+    size_t _contentLength = 0;
+    size_t _sentLength = 0;
+  public:
+    virtual ~AsyncWebServerResponse() {}
+    virtual bool _sourceValid() const { return false; }
+    void addHeader(const String &, const String &) {}
+};
+
+class AsyncAbstractResponse : public AsyncWebServerResponse {
+  public:
+    virtual size_t _fillBuffer(uint8_t *, size_t) { return 0; }
+};
+
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+typedef std::function<size_t(uint8_t*, size_t, size_t)> AwsResponseFiller;
+
+class AsyncChunkedResponse : public AsyncAbstractResponse {
+  private:
+    AwsResponseFiller _content;
+  public:
+    AsyncChunkedResponse(const String &contentType, AwsResponseFiller callback) : _content(callback) { _code = 200; _contentType = contentType; }
+    bool _sourceValid() const override { return !!_content; }
+    size_t _fillBuffer(uint8_t *buf, size_t maxLen) override {
+      size_t len = _content(buf, maxLen, _sentLength);
+      if (len != RESPONSE_TRY_AGAIN) _sentLength += len;
+      return len;
+    }
+};
+
+namespace native { // native only: a harness can look at responses before they are dropped
+  inline std::function<void(AsyncWebServerResponse *)> &onResponse() { static std::function<void(AsyncWebServerResponse *)> f; return f; }
+}
+
+class AsyncWebParameter {
+  private:
+    String _name, _value;
+  public:
+    AsyncWebParameter(const String &name, const String &value) : _name(name), _value(value) {}
+    const String &name() const  { return _name; }
+    const String &value() const { return _value; }
+};
+
+class AsyncWebServerRequest {
+  private:
+    String _url;
+    WebRequestMethodComposite _method = HTTP_GET;
+    std::vector<AsyncWebParameter> _params;
+  public:
+    void *_tempObject = nullptr;
+    AsyncWebServerRequest(const String &url = String(), WebRequestMethodComposite method = HTTP_GET) : _url(url), _method(method) {}
+    WebRequestMethodComposite method() const { return _method; }
+    const String &url() const                { return _url; }
+    void addParam(const String &name, const String &value) { _params.emplace_back(name, value); }
+    bool hasParam(const String &name, bool = false, bool = false) const { return getParam(name) != nullptr; }
+    const AsyncWebParameter *getParam(const String &name, bool = false, bool = false) const {
+      for (const auto &p : _params) if (p.name() == name) return &p;
+      return nullptr;
+    }
+    const AsyncWebParameter *getParam(size_t i) const { return i < _params.size() ? &_params[i] : nullptr; }
+    size_t params() const { return _params.size(); }
+    void addInterestingHeader(const String &) {}
+    void deferResponse() {}
+    void send(int, const String & = String(), const String & = String()) {}
+    void send_P(int, const String &, const char *) {}
+    bool hasArg(const String &name) const { return hasParam(name); }
+    AsyncWebServerResponse *beginResponse_P(int, const String &, const uint8_t *, size_t) { return new AsyncWebServerResponse(); }
+    template<typename FS> AsyncWebServerResponse *beginResponse(FS &, const String &, const String & = String(), bool = false, std::nullptr_t = nullptr) { return new AsyncWebServerResponse(); }
+    AsyncWebServerResponse *beginChunkedResponse(const String &contentType, AwsResponseFiller callback) { return new AsyncChunkedResponse(contentType, callback); }
+    void send(AsyncWebServerResponse *response) { if (native::onResponse()) native::onResponse()(response); delete response; }
+};
+
+class AsyncWebHandler {
+  public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest *) { return false; }
+    virtual void handleRequest(AsyncWebServerRequest *) {}
+    virtual void handleUpload(AsyncWebServerRequest *, const String &, size_t, uint8_t *, size_t, bool) {}
+    virtual void handleBody(AsyncWebServerRequest *, uint8_t *, size_t, size_t, size_t) {}
+    virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+struct AsyncWebServerQueueLimits {
+  size_t nMaxParallel;
+  size_t nMaxQueued;
+  size_t nMinHeap;
+  size_t nHeapUsage;
+};
+
+class AsyncWebServer {
+  public:
+    AsyncWebServer(uint16_t, const AsyncWebServerQueueLimits & = {0, 0, 0, 0}) {}
+    void begin() {}
+    void end()   {}
+};
+
+typedef enum { WS_CONTINUATION, WS_TEXT, WS_BINARY } AwsFrameType;
+typedef struct {
+  uint8_t  message_opcode;
+  uint32_t num;
+  uint8_t  final;
+  uint8_t  masked;
+  uint8_t  opcode;
+  uint64_t len;
+  uint8_t  mask[4];
+  uint64_t index;
+} AwsFrameInfo;
+
+class AsyncWebSocketBuffer {
+  public:
+    explicit AsyncWebSocketBuffer(size_t size) : _data(size) {}
+    uint8_t *data()                  { return _data.data(); }
+    size_t   size() const            { return _data.size(); }
+    explicit operator bool() const   { return true; }
+  private:
+    std::vector<uint8_t> _data;
+};
+
+// messages are accepted and dropped
+class AsyncWebSocketClient {
+  public:
+    uint32_t id() const                        { return 0; }
+    size_t   queueLength() const               { return 0; }
+    void     text(const String &)              {}
+    void     text(AsyncWebSocketBuffer)        {}
+    void     binary(AsyncWebSocketBuffer)      {}
+};
+
+class AsyncWebSocket : public AsyncWebHandler {
+  public:
+    AsyncWebSocket(const String &) {}
+    size_t count() const { return 0; }
+    void   cleanupClients(uint16_t = 0) {}
+    AsyncWebSocketClient *client(uint32_t)     { return nullptr; }
+    void   textAll(const String &)             {}
+    void   textAll(AsyncWebSocketBuffer)       {}
+    void   closeAll(uint16_t = 0)              {}
+};
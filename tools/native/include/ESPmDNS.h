@@ -0,0 +1,11 @@
+#pragma once
+// host stand-in for ESPmDNS (no service discovery)
+#include <Arduino.h>
+
+class MDNSResponder {
+  public:
+    bool begin(const char *) { return false; }
+    void end() {}
+    void addService(const char *, const char *, uint16_t) {}
+};
+inline MDNSResponder MDNS;
@@ -0,0 +1,12 @@
+#pragma once
+// host stand-in for the ESP32 Ethernet library (no wired interface)
+#include <Arduino.h>
+
+class ETHClass {
+  public:
+    IPAddress localIP()    { return IPAddress(0, 0, 0, 0); }
+    IPAddress subnetMask() { return IPAddress(0, 0, 0, 0); }
+    IPAddress gatewayIP()  { return IPAddress(0, 0, 0, 0); }
+    bool      linkUp()     { return false; }
+};
+inline ETHClass ETH;
@@ -0,0 +1,3 @@
+#pragma once
+// Serial is part of the host Arduino.h stand-in
+#include <Arduino.h>
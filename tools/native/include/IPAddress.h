@@ -0,0 +1,3 @@
+#pragma once
+// IPAddress is part of the host Arduino.h stand-in
+#include <Arduino.h>
@@ -0,0 +1,64 @@
+#pragma once
+/*
+ * host stand-in for LittleFS: file system calls are mapped onto a host directory
+ * (the current working directory, or $WLED_FS_ROOT if set), so ledmaps, palettes
+ * and presets can be tested by dropping the JSON files next to the binary.
+ */
+#include <Arduino.h>
+#include <sys/stat.h>
+
+namespace native {
+  inline std::string fsPath(const char *path) {
+    const char *root = getenv("WLED_FS_ROOT");
+    std::string p(root && *root ? root : ".");
+    if (path && *path != '/') p += '/';
+    if (path) p += path;
+    return p;
+  }
+}
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Stream {
+  private:
+    FILE  *_f = nullptr;
+    String _name;
+  public:
+    File() {}
+    File(FILE *f, const char *name) : _f(f), _name(name) {}
+    operator bool() const                         { return _f != nullptr; }
+    size_t write(uint8_t c) override              { return _f ? fwrite(&c, 1, 1, _f) : 0; }
+    size_t write(const uint8_t *b, size_t n) override { return _f ? fwrite(b, 1, n, _f) : 0; }
+    using Print::write;
+    int    read() override                        { return _f ? fgetc(_f) : -1; }
+    size_t read(uint8_t *buf, size_t size)        { return _f ? fread(buf, 1, size, _f) : 0; }
+    int    peek() override                        { if (!_f) return -1; int c = fgetc(_f); if (c >= 0) ungetc(c, _f); return c; }
+    int    available() override                   { if (!_f) return 0; long p = ftell(_f); return p < 0 ? 0 : int(size() - p); }
+    void   flush() override                       { if (_f) fflush(_f); }
+    bool   seek(uint32_t pos, SeekMode mode = SeekSet) { return _f && fseek(_f, pos, mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END) == 0; }
+    size_t position() const                       { return _f ? ftell(_f) : 0; }
+    size_t size() const                           { struct stat st; if (_f) fflush(_f); return _f && fstat(fileno(_f), &st) == 0 ? st.st_size : 0; }
+    const char *name() const                      { return _name.c_str(); }
+    bool   isDirectory() const                    { return false; }
+    void   close()                                { if (_f) fclose(_f); _f = nullptr; }
+};
+
+class LittleFSFS {
+  public:
+    bool   begin(bool = false)                    { return true; }
+    void   end()                                  {}
+    bool   exists(const char *path)               { struct stat st; return stat(native::fsPath(path).c_str(), &st) == 0; }
+    bool   exists(const String &path)             { return exists(path.c_str()); }
+    File   open(const char *path, const char *mode = "r") {
+      const char *m = (mode && *mode == 'w') ? "w+b" : (mode && *mode == 'a') ? "a+b" : (mode && strchr(mode, '+')) ? "r+b" : "rb";
+      FILE *f = fopen(native::fsPath(path).c_str(), m);
+      return f ? File(f, path) : File();
+    }
+    File   open(const String &path, const char *mode = "r") { return open(path.c_str(), mode); }
+    bool   remove(const char *path)               { return ::remove(native::fsPath(path).c_str()) == 0; }
+    bool   remove(const String &path)             { return remove(path.c_str()); }
+    bool   rename(const char *from, const char *to) { return ::rename(native::fsPath(from).c_str(), native::fsPath(to).c_str()) == 0; }
+    size_t totalBytes()                           { return 1024 * 1024; }
+    size_t usedBytes()                            { return 0; }
+};
+inline LittleFSFS LittleFS;
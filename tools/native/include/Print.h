@@ -0,0 +1,3 @@
+#pragma once
+// Print/Stream are part of the host Arduino.h stand-in
+#include <Arduino.h>
@@ -0,0 +1,10 @@
+#pragma once
+// host stand-in for SPI (no SPI bus)
+#include <Arduino.h>
+
+class SPIClass {
+  public:
+    void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+    void end() {}
+};
+inline SPIClass SPI;
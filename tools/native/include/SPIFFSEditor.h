@@ -0,0 +1,10 @@
+#pragma once
+// host stand-in for the Aircoookie SPIFFSEditor (types only)
+#include <ESPAsyncWebServer.h>
+
+#define SPIFFS_EDITOR_AIRCOOOKIE
+
+class SPIFFSEditor : public AsyncWebHandler {
+  public:
+    template<typename... Args> SPIFFSEditor(Args&&...) {}
+};
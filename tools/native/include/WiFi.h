@@ -0,0 +1,97 @@
+#pragma once
+// host stand-in for the ESP32 WiFi library: the host is always "connected" on the loopback address
+#include <Arduino.h>
+
+namespace native {
+  // networking between native instances on one host (see WiFiUdp.h):
+  //   $WLED_NATIVE_IP     loopback address of this instance (127.0.0.x), enables real UDP sockets
+  //   $WLED_NATIVE_PEERS  comma separated addresses of the other instances, broadcasts go to each of them
+  struct Net {
+    IPAddress ip = IPAddress(127, 0, 0, 1);
+    std::vector<IPAddress> peers;
+    bool sockets = false;
+    Net() {
+      if (!getenv("WLED_NATIVE_IP") || !ip.fromString(getenv("WLED_NATIVE_IP"))) return;
+      sockets = true;
+      std::string list = getenv("WLED_NATIVE_PEERS") ? getenv("WLED_NATIVE_PEERS") : "";
+      for (size_t pos = 0; pos < list.size(); ) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        IPAddress peer;
+        if (peer.fromString(list.substr(pos, end - pos).c_str()) && peer != ip) peers.push_back(peer);
+        pos = end + 1;
+      }
+    }
+  };
+  inline Net &net() { static Net n; return n; }
+}
+
+typedef enum {
+  WL_IDLE_STATUS     = 0,
+  WL_NO_SSID_AVAIL   = 1,
+  WL_SCAN_COMPLETED  = 2,
+  WL_CONNECTED       = 3,
+  WL_CONNECT_FAILED  = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED    = 6,
+} wl_status_t;
+
+typedef enum {
+  WIFI_POWER_19_5dBm = 78,
+  WIFI_POWER_8_5dBm  = 34,
+} wifi_power_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+
+typedef enum { WIFI_AUTH_OPEN = 0, WIFI_AUTH_WEP, WIFI_AUTH_WPA_PSK, WIFI_AUTH_WPA2_PSK } wifi_auth_mode_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+#define WIFI_MODE_NULL  WIFI_OFF
+#define WIFI_MODE_STA   WIFI_STA
+#define WIFI_MODE_AP    WIFI_AP
+#define WIFI_MODE_APSTA WIFI_AP_STA
+
+typedef enum {
+  ARDUINO_EVENT_WIFI_READY = 0,
+  ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+  ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+  ARDUINO_EVENT_ETH_START = 18,
+  ARDUINO_EVENT_ETH_CONNECTED = 20,
+  ARDUINO_EVENT_ETH_DISCONNECTED = 21,
+} arduino_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+
+class WiFiClass {
+  public:
+    wl_status_t status()                  { return WL_CONNECTED; }
+    wifi_mode_t getMode()                 { return WIFI_STA; }
+    bool        mode(wifi_mode_t)         { return true; }
+    IPAddress   localIP()                 { return native::net().ip; }
+    IPAddress   subnetMask()              { return IPAddress(255, 0, 0, 0); }
+    IPAddress   gatewayIP()               { return IPAddress(127, 0, 0, 1); }
+    IPAddress   softAPIP()                { return IPAddress(0, 0, 0, 0); }
+    int32_t     RSSI()                    { return -50; }
+    int32_t     channel()                 { return 1; }
+    String      SSID()                    { return String("native"); }
+    String      BSSIDstr()                { return String("00:00:00:00:00:00"); }
+    // no networks are ever found
+    int16_t     scanNetworks(bool = false, bool = false) { return 0; }
+    int16_t     scanComplete()            { return 0; }
+    void        scanDelete()              {}
+    String      SSID(int)                 { return String(); }
+    int32_t     RSSI(int)                 { return 0; }
+    String      BSSIDstr(int)             { return String(); }
+    int32_t     channel(int)              { return 0; }
+    wifi_auth_mode_t encryptionType(int)  { return WIFI_AUTH_OPEN; }
+    bool        softAPdisconnect(bool = false) { return true; }
+    wifi_power_t getTxPower()             { return WIFI_POWER_19_5dBm; }
+    bool        getSleep()                { return false; }
+    String      macAddress()              { return String("AA:BB:CC:DD:EE:FF"); }
+    uint8_t    *macAddress(uint8_t *mac)  { static const uint8_t m[6] = {0xAA,0xBB,0xCC,0xDD,0xEE,0xFF}; memcpy(mac, m, 6); return mac; }
+    uint8_t     softAPgetStationNum()     { return 0; }
+    bool        setTxPower(wifi_power_t)  { return true; }
+    bool        setSleep(bool)            { return true; }
+    bool        disconnect(bool = false)  { return true; }
+};
+inline WiFiClass WiFi;
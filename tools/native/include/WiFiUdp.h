@@ -0,0 +1,86 @@
+#pragma once
+// host stand-in for WiFiUDP. By default sockets are never opened, sends are accepted and dropped.
+// A harness can hand a socket one received packet with receive(), which the next
+// parsePacket()/read() calls return as if it had arrived from the network.
+// With $WLED_NATIVE_IP set (see WiFi.h) begin() opens a real non-blocking UDP socket on that
+// address, so instances on one host talk over loopback; broadcasts go to $WLED_NATIVE_PEERS.
+#include <Arduino.h>
+#include <WiFi.h>
+#include <vector>
+
+namespace native { // POSIX UDP sockets, native_net.cpp (kept out of here, the system headers clash with the Arduino names)
+  int  udpOpen(uint32_t ip, uint16_t port);
+  void udpClose(int fd);
+  void udpSend(int fd, uint32_t ip, uint16_t port, const uint8_t *data, size_t len);
+  int  udpReceive(int fd, uint8_t *buf, size_t len, uint32_t &ip, uint16_t &port);
+}
+
+class WiFiUDP : public Stream {
+  public:
+    ~WiFiUDP()                                       { stop(); }
+    uint8_t   begin(uint16_t port) {
+      stop();
+      if (native::net().sockets) _fd = native::udpOpen(native::net().ip, port);
+      return _fd >= 0;
+    }
+    uint8_t   beginMulticast(IPAddress, uint16_t)    { return 0; }
+    void      stop()                                 { if (_fd >= 0) native::udpClose(_fd); _fd = -1; }
+    int       beginPacket(IPAddress ip, uint16_t port) { _txIP = ip; _txPort = port; _tx.clear(); return 1; }
+    int       beginPacket(const char *, uint16_t)    { _txPort = 0; return 1; }
+    int       beginMulticastPacket()                 { _txPort = 0; return 1; }
+    int       endPacket() {
+      if (_fd < 0 || !_txPort) return 1;
+      if (_txIP[3] == 255) { // broadcast: one copy per peer
+        for (const IPAddress &peer : native::net().peers) sendTo(peer);
+      } else sendTo(_txIP);
+      _tx.clear();
+      return 1;
+    }
+    size_t    write(uint8_t c) override              { _tx.push_back(c); return 1; }
+    size_t    write(const uint8_t *buf, size_t size) override { _tx.insert(_tx.end(), buf, buf + size); return size; }
+    using Print::write;
+    int       parsePacket() {
+      _packet.swap(_pending);
+      _pending.clear();
+      _pos = 0;
+      if (_packet.empty() && _fd >= 0) {
+        uint8_t buf[2048];
+        uint32_t ip = 0;
+        int n = native::udpReceive(_fd, buf, sizeof(buf), ip, _remotePort);
+        if (n > 0) { _packet.assign(buf, buf + n); _remoteIP = IPAddress(ip); }
+      }
+      return _packet.size();
+    }
+    int       available() override                   { return _packet.size() - _pos; }
+    int       read() override                        { return _pos < _packet.size() ? _packet[_pos++] : -1; }
+    int       read(unsigned char *buf, size_t len) {
+      len = std::min(len, _packet.size() - _pos);
+      memcpy(buf, _packet.data() + _pos, len);
+      _pos += len;
+      return len;
+    }
+    int       read(char *buf, size_t len)            { return read(reinterpret_cast<unsigned char *>(buf), len); }
+    int       peek() override                        { return _pos < _packet.size() ? _packet[_pos] : -1; }
+    void      flush() override                       {}
+    IPAddress remoteIP()                             { return _remoteIP; }
+    uint16_t  remotePort()                           { return _remotePort; }
+
+    // native only: queue a packet for the next parsePacket()
+    void      receive(const uint8_t *data, size_t len, IPAddress from) {
+      _pending.assign(data, data + len);
+      _remoteIP = from;
+    }
+
+  private:
+    void      sendTo(IPAddress ip)                   { native::udpSend(_fd, ip, _txPort, _tx.data(), _tx.size()); }
+
+    std::vector<uint8_t> _packet;  // packet returned by the last parsePacket()
+    std::vector<uint8_t> _pending; // packet for the next parsePacket()
+    std::vector<uint8_t> _tx;      // packet being assembled between beginPacket() and endPacket()
+    size_t    _pos = 0;
+    int       _fd = -1;
+    IPAddress _remoteIP;
+    uint16_t  _remotePort = 0;
+    IPAddress _txIP;
+    uint16_t  _txPort = 0;
+};
@@ -0,0 +1,9 @@
+#pragma once
+// host stand-in for Wire (no I2C bus)
+#include <Arduino.h>
+
+class TwoWire {
+  public:
+    bool begin(int = -1, int = -1, uint32_t = 0) { return false; }
+};
+inline TwoWire Wire;
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef BusWrapper_h
+#define BusWrapper_h
+/*
+ * Host stand-in for bus_wrapper.h (included by bus_manager.cpp when WLED_NATIVE is defined).
+ *
+ * Digital buses render into a plain in-memory pixel buffer instead of a NeoPixelBus
+ * driver, so BusDigital (color order, CCT, ABL, double buffering) runs unmodified.
+ * Like NeoPixelBusLg, brightness is applied when a pixel is set, so getPixelColor()
+ * returns the dimmed value and restoreColorLossy() round-trips exactly as on target.
+ */
+#include <vector>
+
+#define I_NONE     0
+#define I_NATIVE_3 1 // RGB
+#define I_NATIVE_4 2 // RGBW
+#define I_NATIVE_5 3 // RGB + WW/CW
+
+struct NativeBus {
+  std::vector<uint32_t> pixels;
+  std::vector<uint16_t> wwcw;
+  uint8_t  luminance;
+  uint32_t shows;
+  explicit NativeBus(uint16_t len) : pixels(len, 0), wwcw(len, 0), luminance(255), shows(0) {}
+};
+
+class PolyBus {
+  private:
+    static bool _useParallelI2S;
+
+    static inline uint8_t dim(uint8_t v, uint8_t l) { return (uint16_t(v) * (uint16_t(l) + 1)) >> 8; }
+
+  public:
+    static inline void setParallelI2S1Output(bool b = true) { _useParallelI2S = b; }
+    static inline bool isParallelI2S1Output(void) { return _useParallelI2S; }
+
+    static void begin(void*, uint8_t, uint8_t*, uint16_t) {}
+
+    static void* create(uint8_t busType, uint8_t*, uint16_t len, uint8_t) {
+      if (busType == I_NONE) return nullptr;
+      return new NativeBus(len);
+    }
+
+    static void show(void* busPtr, uint8_t busType, bool consistent = true) {
+      if (busType == I_NONE || !busPtr) return;
+      static_cast<NativeBus*>(busPtr)->shows++;
+    }
+
+    static bool canShow(void*, uint8_t) { return true; }
+
+    static void setBrightness(void* busPtr, uint8_t busType, uint8_t b) {
+      if (busType == I_NONE || !busPtr) return;
+      static_cast<NativeBus*>(busPtr)->luminance = b;
+    }
+
+    [[gnu::hot]] static void setPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint32_t c, uint8_t co, uint16_t wwcw = 0) {
+      if (busType == I_NONE || !busPtr) return;
+      NativeBus *bus = static_cast<NativeBus*>(busPtr);
+      if (pix >= bus->pixels.size()) return;
+      uint8_t l = bus->luminance;
+      bus->pixels[pix] = (uint32_t(dim(c >> 24, l)) << 24) | (uint32_t(dim(c >> 16, l)) << 16) | (uint32_t(dim(c >> 8, l)) << 8) | dim(c, l);
+      bus->wwcw[pix]   = (uint16_t(dim(wwcw >> 8, l)) << 8) | dim(wwcw, l);
+    }
+
+    [[gnu::hot]] static uint32_t getPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint8_t co) {
+      if (busType == I_NONE || !busPtr) return 0;
+      NativeBus *bus = static_cast<NativeBus*>(busPtr);
+      return pix < bus->pixels.size() ? bus->pixels[pix] : 0;
+    }
+
+    static void cleanup(void* busPtr, uint8_t busType) {
+      if (busPtr == nullptr) return;
+      delete static_cast<NativeBus*>(busPtr);
+    }
+
+    static unsigned getDataSize(void* busPtr, uint8_t busType) {
+      if (busType == I_NONE || !busPtr) return 0;
+      return static_cast<NativeBus*>(busPtr)->pixels.size() * (busType + 2);
+    }
+
+    static unsigned memUsage(unsigned count, unsigned busType) {
+      return busType == I_NONE ? 0 : count * (busType + 2);
+    }
+
+    static uint8_t getI(uint8_t busType, const uint8_t* pins, uint8_t num = 0) {
+      if (!Bus::isDigital(busType)) return I_NONE;
+      if (Bus::hasCCT(busType)) return I_NATIVE_5;
+      return Bus::hasWhite(busType) ? I_NATIVE_4 : I_NATIVE_3;
+    }
+};
+#endif
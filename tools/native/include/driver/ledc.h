@@ -0,0 +1,23 @@
+#pragma once
+// host stand-in for ESP-IDF driver/ledc.h (channel counts and the few HAL calls used by BusPwm)
+#include <stdint.h>
+
+typedef enum {
+  LEDC_HIGH_SPEED_MODE = 0,
+  LEDC_LOW_SPEED_MODE,
+  LEDC_SPEED_MODE_MAX,
+} ledc_mode_t;
+
+typedef enum {
+  LEDC_CHANNEL_0 = 0, LEDC_CHANNEL_1, LEDC_CHANNEL_2, LEDC_CHANNEL_3,
+  LEDC_CHANNEL_4, LEDC_CHANNEL_5, LEDC_CHANNEL_6, LEDC_CHANNEL_7,
+  LEDC_CHANNEL_MAX,
+} ledc_channel_t;
+
+typedef enum {
+  LEDC_TIMER_0 = 0, LEDC_TIMER_1, LEDC_TIMER_2, LEDC_TIMER_3,
+  LEDC_TIMER_MAX,
+} ledc_timer_t;
+
+inline int ledc_timer_rst(ledc_mode_t, ledc_timer_t)     { return 0; }
+inline int ledc_update_duty(ledc_mode_t, ledc_channel_t) { return 0; }
@@ -0,0 +1,6 @@
+#pragma once
+// host stand-in for the ESP-IDF task watchdog
+inline int esp_task_wdt_init(unsigned, bool) { return 0; }
+inline int esp_task_wdt_add(void *)          { return 0; }
+inline int esp_task_wdt_delete(void *)       { return 0; }
+inline int esp_task_wdt_reset()              { return 0; }
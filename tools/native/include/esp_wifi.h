@@ -0,0 +1,3 @@
+#pragma once
+// host stand-in for ESP-IDF esp_wifi.h (nothing is used by the native build)
+#include <WiFi.h>
@@ -0,0 +1,6 @@
+#pragma once
+// host stand-in for lwIP IGMP (multicast group membership is not emulated)
+#include "ip_addr.h"
+
+inline int igmp_joingroup(const ip4_addr_t *, const ip4_addr_t *)  { return 0; }
+inline int igmp_leavegroup(const ip4_addr_t *, const ip4_addr_t *) { return 0; }
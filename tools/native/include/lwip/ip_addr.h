@@ -0,0 +1,9 @@
+#pragma once
+// host stand-in for lwIP address types used by the vendored E1.31 receiver
+#include <stdint.h>
+#include <arpa/inet.h>
+
+#define LWIP_VERSION_MAJOR 2
+
+typedef struct { uint32_t addr; } ip4_addr_t;
+typedef ip4_addr_t ip_addr_t;
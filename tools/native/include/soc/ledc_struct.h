@@ -0,0 +1,14 @@
+#pragma once
+// host stand-in for the LEDC register block written directly by BusPwm::show()
+#include <stdint.h>
+
+typedef struct {
+  struct {
+    struct {
+      struct { uint32_t duty; }   duty;
+      struct { uint32_t hpoint; } hpoint;
+    } channel[8];
+  } channel_group[2];
+} ledc_dev_t;
+
+inline ledc_dev_t LEDC;
@@ -0,0 +1,6 @@
+#pragma once
+// host stand-in for the ESP32 hardware RNG register (HW_RND_REGISTER in fcn_declare.h)
+#include <Arduino.h>
+
+#define WDEV_RND_REG  0x3FF75144
+#define REG_READ(reg) esp_random()
@@ -0,0 +1,54 @@
+/*
+ * Real UDP sockets for the WiFiUDP stand-in (include/WiFiUdp.h), used when
+ * $WLED_NATIVE_IP gives the instance its own loopback address.
+ * Only the system headers are included: they clash with names of the Arduino stand-in.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace native {
+
+static sockaddr_in address(uint32_t ip, uint16_t port) {
+  sockaddr_in a = {};
+  a.sin_family = AF_INET;
+  a.sin_port = htons(port);
+  a.sin_addr.s_addr = ip; // IPAddress keeps the bytes in network order
+  return a;
+}
+
+int udpOpen(uint32_t ip, uint16_t port) {
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) return -1;
+  int on = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  sockaddr_in a = address(ip, port);
+  if (bind(fd, (sockaddr *)&a, sizeof(a)) < 0) { close(fd); return -1; }
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  return fd;
+}
+
+void udpClose(int fd) {
+  close(fd);
+}
+
+void udpSend(int fd, uint32_t ip, uint16_t port, const uint8_t *data, size_t len) {
+  sockaddr_in a = address(ip, port);
+  sendto(fd, data, len, 0, (sockaddr *)&a, sizeof(a));
+}
+
+int udpReceive(int fd, uint8_t *buf, size_t len, uint32_t &ip, uint16_t &port) {
+  sockaddr_in from = {};
+  socklen_t fromLen = sizeof(from);
+  ssize_t n = recvfrom(fd, buf, len, 0, (sockaddr *)&from, &fromLen);
+  if (n <= 0) return 0;
+  ip = from.sin_addr.s_addr;
+  port = ntohs(from.sin_port);
+  return n;
+}
+
+}
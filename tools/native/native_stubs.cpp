@@ -0,0 +1,54 @@
+#define WLED_DEFINE_GLOBAL_VARS //only in one source file of the native build
+#include "wled.h"
+
+/*
+ * Host (native) build glue.
+ *
+ * Owns WLED's global variables and provides inert replacements for the few
+ * functions the effect engine and bus manager reference from modules that are
+ * not part of the native build (file system, web server, UDP, usermods).
+ * The realtime replay and clock sync builds (WLED_NATIVE_REALTIME) compile udp.cpp,
+ * e131.cpp and clock_sync.cpp and only need the state/preset functions those call.
+ */
+
+// file.cpp
+bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter) { return false; }
+bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter) { return false; }
+
+// wled_server.cpp
+void createEditHandler(bool enable) {}
+
+#ifndef WLED_NATIVE_REALTIME
+// udp.cpp
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri, bool isRGBW, uint16_t startUniverse) { return 0; }
+void realtimeBroadcastSync() {}
+
+// e131.cpp
+void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol) {}
+#else
+// led.cpp
+void stateUpdated(byte callMode) {}
+void updateInterfaces(uint8_t callMode) {}
+byte scaledBri(byte in) { return in; }
+
+// json.cpp
+bool deserializeState(JsonObject root, byte callMode, byte presetId) { return false; }
+
+// playlist.cpp
+void unloadPlaylist() {}
+
+// presets.cpp
+bool applyPreset(byte index, byte callMode) { return false; }
+
+// set.cpp
+bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply) { return false; }
+#endif
+
+// um_manager.cpp (no usermods; audio reactive effects fall back to simulated sound)
+bool UsermodManager::getUMData(um_data_t **data, uint8_t mod_id) { if (data) *data = nullptr; return false; }
+
+// src/dependencies/e131/ESPAsyncE131.cpp (no network listeners on the host)
+ESPAsyncE131::ESPAsyncE131(e131_packet_callback_function callback) : _callback(callback) {}
+bool ESPAsyncE131::begin(bool multicast, uint16_t port, uint16_t universe, uint8_t n) { return false; }
+void ESPAsyncE131::joinUniverse(uint16_t universe) {}
+
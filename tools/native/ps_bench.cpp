@@ -0,0 +1,149 @@
+#include "wled.h"
+#include "FXparticleSystem.h"
+#include <chrono>
+#include <vector>
+
+/*
+ * 2D particle system benchmark for the native (host) build (fx_bench -p).
+ *
+ * Collisions: compares the grid collision detection of ParticleSystem2D with the x-binning it
+ * replaced (still used when there is no heap for the grid) on a 64x64 matrix, for
+ *   spread  - particles all over the matrix
+ *   column  - particles crowded into an 8 pixel wide column; binning overflows here
+ *             and defers part of the collisions to the next frame
+ * Both run on identical particle snapshots. Reported per method:
+ *   us      - time per collision pass
+ *   hit     - particles whose speed changed in one pass, i.e. that were collided
+ *
+ * Kernels: compares moving and accelerating all particles one particle at a time
+ * (particleMoveUpdate(), applyForce(part, ...)) with the batched system functions
+ * update() and applyForce(x, y) use, with half of the particles dead.
+ */
+
+#ifndef WLED_DISABLE_PARTICLESYSTEM2D
+// access to the private collision functions (friend of ParticleSystem2D)
+struct PSCollisionBench {
+  static void grid(ParticleSystem2D *ps)   { ps->handleCollisions(); }
+  static void binned(ParticleSystem2D *ps) { ps->handleCollisionsBinned(); }
+  static void moveSingle(ParticleSystem2D *ps) {
+    for (uint32_t i = 0; i < ps->usedParticles; i++) ps->particleMoveUpdate(ps->particles[i], ps->particleFlags[i]);
+  }
+  static void moveBatched(ParticleSystem2D *ps) { ps->moveParticles(); }
+  static void forceSingle(ParticleSystem2D *ps) {
+    uint8_t counter = 0;
+    for (uint32_t i = 0; i < ps->usedParticles; i++) { counter = 0; ps->applyForce(ps->particles[i], 5, -20, counter); }
+  }
+  static void forceBatched(ParticleSystem2D *ps) { ps->forcecounter = 0; ps->applyForce(5, -20); }
+};
+
+static std::vector<unsigned> benchCounts;
+static unsigned benchPasses;
+static bool benchCsv;
+
+// fill the first 'count' particles; column = crowd them into a narrow column in the middle
+static void placeParticles(ParticleSystem2D *ps, unsigned count, bool column) {
+  srand(count);
+  const int32_t colWidth = 8 * PS_P_RADIUS;
+  for (unsigned i = 0; i < count; i++) {
+    PSparticle &p = ps->particles[i];
+    p.x   = column ? (ps->maxX - colWidth) / 2 + rand() % colWidth : rand() % (ps->maxX + 1);
+    p.y   = rand() % (ps->maxY + 1);
+    p.vx  = rand() % 41 - 20;
+    p.vy  = rand() % 41 - 20;
+    p.ttl = 500;
+    ps->particleFlags[i].asByte = 0;
+    ps->particleFlags[i].collide = true;
+  }
+  ps->usedParticles = count;
+}
+
+// time one collision method over benchPasses passes, each starting from the same snapshot
+static double timePasses(ParticleSystem2D *ps, void (*method)(ParticleSystem2D *), const std::vector<PSparticle> &snapshot, unsigned &hits) {
+  const size_t bytes = snapshot.size() * sizeof(PSparticle);
+  double ns = 0;
+  for (unsigned n = 0; n < benchPasses; n++) {
+    memcpy(ps->particles, snapshot.data(), bytes);
+    auto t0 = std::chrono::steady_clock::now();
+    method(ps);
+    ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+  }
+  hits = 0;
+  for (size_t i = 0; i < snapshot.size(); i++)
+    if (ps->particles[i].vx != snapshot[i].vx || ps->particles[i].vy != snapshot[i].vy) hits++;
+  return ns / benchPasses;
+}
+
+// runs the whole benchmark on its first call, from within strip.service() so SEGMENT/SEGENV are valid
+static uint16_t mode_ps_collision_bench(void) {
+  ParticleSystem2D *PartSys = nullptr;
+  if (SEGENV.call != 0) return FRAMETIME;
+  if (!initParticleSystem2D(PartSys, 1)) {
+    fprintf(stderr, "particle system init failed\n");
+    return FRAMETIME;
+  }
+  PartSys->updateSystem();
+  PartSys->enableParticleCollisions(true, 255);
+  const unsigned available = PartSys->usedParticles; // all allocated particles are used after init
+
+  if (benchCsv) printf("particles,layout,binned_us,binned_hit,grid_us,grid_hit,speedup\n");
+  else printf("\n2D particle collisions, %ux%u, %u passes\n%-9s %-7s %10s %8s %10s %8s %8s\n",
+              PartSys->maxXpixel + 1, PartSys->maxYpixel + 1, benchPasses, "particles", "layout", "binned us", "hit", "grid us", "hit", "speedup");
+  for (unsigned count : benchCounts) {
+    if (count > available) {
+      fprintf(stderr, "skipping %u particles (system has %u)\n", count, available);
+      continue;
+    }
+    for (int column = 0; column < 2; column++) {
+      placeParticles(PartSys, count, column);
+      std::vector<PSparticle> snapshot(PartSys->particles, PartSys->particles + count);
+      unsigned binnedHits, gridHits;
+      double binned = timePasses(PartSys, PSCollisionBench::binned, snapshot, binnedHits);
+      double grid   = timePasses(PartSys, PSCollisionBench::grid, snapshot, gridHits);
+      const char *layout = column ? "column" : "spread";
+      if (benchCsv) printf("%u,%s,%.2f,%u,%.2f,%u,%.2f\n", count, layout, binned / 1000, binnedHits, grid / 1000, gridHits, binned / grid);
+      else printf("%-9u %-7s %10.2f %8u %10.2f %8u %7.2fx\n", count, layout, binned / 1000, binnedHits, grid / 1000, gridHits, binned / grid);
+    }
+  }
+
+  PartSys->setBounceX(true);
+  PartSys->setBounceY(true);
+  if (benchCsv) printf("particles,kernel,single_us,batched_us,speedup\n");
+  else printf("\n2D particle kernels, %u passes, half of the particles dead\n%-9s %-7s %10s %10s %8s\n", benchPasses, "particles", "kernel", "single us", "batch us", "speedup");
+  for (unsigned count : benchCounts) {
+    if (count > available) continue;
+    placeParticles(PartSys, count, false);
+    for (unsigned i = 0; i < count; i += 2) PartSys->particles[i].ttl = 0;
+    std::vector<PSparticle> snapshot(PartSys->particles, PartSys->particles + count);
+    unsigned hits;
+    double single  = timePasses(PartSys, PSCollisionBench::moveSingle, snapshot, hits);
+    double batched = timePasses(PartSys, PSCollisionBench::moveBatched, snapshot, hits);
+    if (benchCsv) printf("%u,move,%.2f,%.2f,%.2f\n", count, single / 1000, batched / 1000, single / batched);
+    else printf("%-9u %-7s %10.2f %10.2f %7.2fx\n", count, "move", single / 1000, batched / 1000, single / batched);
+    single  = timePasses(PartSys, PSCollisionBench::forceSingle, snapshot, hits);
+    batched = timePasses(PartSys, PSCollisionBench::forceBatched, snapshot, hits);
+    if (benchCsv) printf("%u,force,%.2f,%.2f,%.2f\n", count, single / 1000, batched / 1000, single / batched);
+    else printf("%-9u %-7s %10.2f %10.2f %7.2fx\n", count, "force", single / 1000, batched / 1000, single / batched);
+  }
+  return FRAMETIME;
+}
+static const char _data_FX_MODE_PS_COLLISION_BENCH[] PROGMEM = "PS collision bench@;;;2";
+
+// called by fx_bench with the strip already set up as a 64x64 matrix
+int psCollisionBench(const std::vector<unsigned> &counts, unsigned passes, bool csv) {
+  benchCounts = counts;
+  benchPasses = passes;
+  benchCsv    = csv;
+  uint8_t id = strip.addEffect(255, &mode_ps_collision_bench, _data_FX_MODE_PS_COLLISION_BENCH);
+  if (id == 255) return 1;
+  strip.getMainSegment().setMode(id);
+  native::advanceClock(FRAMETIME_FIXED);
+  strip.trigger();
+  strip.service();
+  return 0;
+}
+#else
+int psCollisionBench(const std::vector<unsigned> &counts, unsigned passes, bool csv) {
+  fprintf(stderr, "2D particle system is disabled\n");
+  return 1;
+}
+#endif
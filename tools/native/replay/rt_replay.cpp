@@ -0,0 +1,273 @@
+#include "wled.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <vector>
+
+/*
+ * Realtime ingest replay for the native (host) build.
+ *
+ * Plays a capture of realtime UDP traffic (written by tools/realtime_capture.py)
+ * into WLED's receive paths on a simulated clock:
+ *   DDP, E1.31, Art-Net  - handed to handleE131Packet() like the ESPAsyncE131 listeners do
+ *   WARLS/DRGB/.., TPM2  - queued on notifierUdp/notifier2Udp, picked up by handleNotifications()
+ *   Hyperion raw RGB     - queued on rgbUdp
+ * Between packets the main loop is emulated by calling handleNotifications() every
+ * loop period, so frame assembly, realtime timeouts and the show() rate limit behave
+ * as on a device. Reported:
+ *   packets/s - packets the host handles per second of processing time (ingest + show)
+ *   latency   - simulated time from packet arrival to the show() that output it
+ *   frames    - frames in the capture, frames shown, lost/out-of-order/repeated packets
+ *               according to the protocol sequence numbers
+ *
+ * usage: rt_replay [-l leds] [-x speed] [-u universe] [-m dmxmode] [-t frametimeout] [-p loopus] capture.wrc
+ */
+
+static const uint8_t replayPins[] = {2,4,5,12,13,14,15,16,17,18,19,21,22,23,25,26,27,32,33};
+static const char    captureMagic[8] = {'W','L','E','D','R','T','C','1'};
+
+struct Packet {
+  uint64_t  us;     // arrival, relative to the start of the capture
+  IPAddress from;
+  uint16_t  port;   // destination port
+  std::vector<uint8_t> data;
+};
+
+// protocol a packet belongs to, for sequence checks
+enum Source : uint8_t { S_NONE, S_DDP, S_E131, S_ARTNET, S_UDP, S_HYPERION, S_TPM2 };
+static const char *sourceNames[] = {"other", "DDP", "E1.31", "Art-Net", "UDP realtime", "Hyperion", "TPM2.NET"};
+
+struct SeqState {
+  int      last = -1;
+  unsigned lost = 0, late = 0, repeated = 0;
+};
+
+struct Stats {
+  unsigned packets[7] = {0};
+  unsigned frames = 0;             // frames in the capture (DDP push, first universe, ...)
+  unsigned shows = 0;
+  unsigned rejected = 0;           // packets the listeners would drop
+  std::map<uint32_t, SeqState> seq;
+  std::vector<uint32_t> latencyUs; // packet arrival to show()
+  std::vector<uint32_t> pendingUs; // arrival of packets not yet shown
+  double   busyNs = 0;             // host time spent handling packets and loop calls
+};
+
+static Stats stats;
+
+static bool readCapture(const char *file, std::vector<Packet> &out) {
+  FILE *f = fopen(file, "rb");
+  if (!f) { perror(file); return false; }
+  char magic[8];
+  if (fread(magic, 1, 8, f) != 8 || memcmp(magic, captureMagic, 8)) {
+    fprintf(stderr, "%s: not a WLED realtime capture\n", file);
+    fclose(f);
+    return false;
+  }
+  uint8_t hdr[16]; // uint64 time (us), IPv4, uint16 port, uint16 length; little endian
+  while (fread(hdr, 1, sizeof(hdr), f) == sizeof(hdr)) {
+    Packet p;
+    p.us = 0;
+    for (int i = 7; i >= 0; i--) p.us = (p.us << 8) | hdr[i];
+    p.from = IPAddress(hdr[8], hdr[9], hdr[10], hdr[11]);
+    p.port = hdr[12] | (hdr[13] << 8);
+    p.data.resize(hdr[14] | (hdr[15] << 8));
+    if (fread(p.data.data(), 1, p.data.size(), f) != p.data.size()) break;
+    out.push_back(std::move(p));
+  }
+  fclose(f);
+  return true;
+}
+
+static bool setupStrip(unsigned leds) {
+  if (leds == 0 || leds > MAX_LEDS) return false;
+  BusManager::removeAll();
+  busConfigs.clear();
+  unsigned start = 0, n = 0;
+  while (start < leds && n < sizeof(replayPins)) {
+    uint8_t pins[OUTPUT_MAX_PINS] = {replayPins[n++]};
+    unsigned len = min(leds - start, (unsigned)MAX_LEDS_PER_BUS);
+    busConfigs.emplace_back(TYPE_WS2812_RGB, pins, start, len, COL_ORDER_GRB, false, 0, RGBW_MODE_MANUAL_ONLY, 0, useGlobalLedBuffer);
+    start += len;
+  }
+  strip.finalizeInit();
+  strip.makeAutoSegments(true);
+  return strip.getLengthTotal() >= leds;
+}
+
+// sequence number check, modulo is the number of sequence values in use
+static void checkSequence(uint32_t key, int seq, int modulo) {
+  SeqState &s = stats.seq[key];
+  int d = s.last < 0 ? 1 : (seq - s.last + modulo) % modulo;
+  if      (d == 0)          s.repeated++;
+  else if (d > modulo / 2)  s.late++;
+  else                    { s.lost += d - 1; s.last = seq; }
+}
+
+// classify like ESPAsyncE131::parsePacket() and handleNotifications(), count frames and check sequences
+static Source classify(const Packet &p, byte &protocol) {
+  const uint8_t *d = p.data.data();
+  const size_t len = p.data.size();
+  if (p.port == DDP_DEFAULT_PORT) {
+    if (len < 10) return S_NONE;
+    protocol = P_DDP;
+    if (d[1] & 0x0F) checkSequence(S_DDP << 16, d[1] & 0x0F, 15); // 1..15, 0 = not used
+    if (d[0] & DDP_PUSH_FLAG) stats.frames++;
+    return S_DDP;
+  }
+  if (p.port == E131_DEFAULT_PORT || p.port == ARTNET_DEFAULT_PORT || p.port == e131Port) {
+    if (len >= 126 && !memcmp(d + 4, "ASC-E1.17", 9)) {
+      protocol = P_E131;
+      if (d[21] != 0x04) return S_E131; // sync packet
+      uint16_t uni = (d[113] << 8) | d[114];
+      checkSequence((S_E131 << 16) | uni, d[111], 256);
+      if (uni == e131Universe) stats.frames++;
+      return S_E131;
+    }
+    if (len >= 18 && !memcmp(d, "Art-Net", 8)) {
+      protocol = P_ARTNET;
+      uint16_t op = d[8] | (d[9] << 8);
+      if (op != ARTNET_OPCODE_OPDMX) return op == ARTNET_OPCODE_OPSYNC || op == ARTNET_OPCODE_OPPOLL ? S_ARTNET : S_NONE;
+      uint16_t uni = d[14] | (d[15] << 8);
+      if (d[12]) checkSequence((S_ARTNET << 16) | uni, d[12], 255); // 1..255, 0 = not used
+      if (uni == e131Universe) stats.frames++;
+      return S_ARTNET;
+    }
+    return S_NONE;
+  }
+  if (p.port == udpRgbPort) { stats.frames++; return S_HYPERION; }
+  if (len > 0 && d[0] == 0x9C) { // TPM2.NET: frame complete with its last packet
+    if (len > 5 && d[1] == 0xDA && d[4] == d[5]) stats.frames++;
+    return S_TPM2;
+  }
+  if (len > 1 && d[0] > 0 && d[0] < 5) { // DNRGB frames start at LED 0, the others are one packet each
+    if (d[0] != 4 || (len > 3 && d[2] == 0 && d[3] == 0)) stats.frames++;
+    return S_UDP;
+  }
+  return S_NONE;
+}
+
+static void onShow() {
+  const uint32_t now = micros();
+  stats.shows++;
+  for (uint32_t t : stats.pendingUs) stats.latencyUs.push_back(now - t);
+  stats.pendingUs.clear();
+}
+
+// one main loop iteration, timed
+static void loopOnce() {
+  auto t0 = std::chrono::steady_clock::now();
+  handleNotifications();
+  stats.busyNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static uint32_t percentile(std::vector<uint32_t> &v, unsigned pct) {
+  if (v.empty()) return 0;
+  size_t i = std::min(v.size() - 1, v.size() * pct / 100);
+  std::nth_element(v.begin(), v.begin() + i, v.end());
+  return v[i];
+}
+
+static void usage() {
+  fprintf(stderr, "usage: rt_replay [-l leds] [-x speed] [-u universe] [-m dmxmode] [-t frametimeout] [-p loopus] capture.wrc\n"
+                  "  -l  number of LEDs (default 1000)\n"
+                  "  -x  playback speed, 2 = twice as fast as captured (default 1)\n"
+                  "  -u  E1.31/Art-Net start universe (default 1)\n"
+                  "  -m  DMX mode as in Sync settings (default 4, multi RGB)\n"
+                  "  -t  multi-universe frame timeout in ms (default 100, 0 = show every universe)\n"
+                  "  -p  main loop period in us (default 1000)\n");
+}
+
+int main(int argc, char **argv) {
+  unsigned leds = 1000, loopUs = 1000;
+  double speed = 1;
+  const char *file = nullptr;
+  e131Universe = 1;
+  DMXMode = DMX_MODE_MULTIPLE_RGB;
+
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    const char *v = (i + 1 < argc) ? argv[i + 1] : "";
+    if      (!strcmp(a, "-l")) { leds   = atoi(v); i++; }
+    else if (!strcmp(a, "-x")) { speed  = atof(v); i++; }
+    else if (!strcmp(a, "-u")) { e131Universe = atoi(v); i++; }
+    else if (!strcmp(a, "-m")) { DMXMode = atoi(v); i++; }
+    else if (!strcmp(a, "-t")) { e131FrameTimeout = atoi(v); i++; }
+    else if (!strcmp(a, "-p")) { loopUs = max(1, atoi(v)); i++; }
+    else if (a[0] != '-' && !file) file = a;
+    else { usage(); return 1; }
+  }
+  if (!file || speed <= 0) { usage(); return 1; }
+
+  std::vector<Packet> packets;
+  if (!readCapture(file, packets)) return 1;
+  if (packets.empty()) { fprintf(stderr, "%s: no packets\n", file); return 1; }
+
+  pDoc = new PSRAMDynamicJsonDocument(JSON_BUFFER_SIZE);
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal);
+  native::useManualClock();
+  if (!setupStrip(leds)) { fprintf(stderr, "cannot set up %u LEDs\n", leds); return 1; }
+  strip.setShowCallback(onShow);
+  interfacesInited = true;
+  udpConnected = udp2Connected = udpRgbConnected = true;
+  receiveDirect = true;
+  notificationCount = udpNumRetries; // no notification retries
+
+  static e131_packet_t e131Buffer;
+  const uint64_t startUs = native::clock().manualUs;
+  auto wall0 = std::chrono::steady_clock::now();
+
+  for (const Packet &p : packets) {
+    const uint64_t at = startUs + uint64_t(p.us / speed);
+    while (native::clock().manualUs + loopUs <= at) { // main loop runs until the packet arrives
+      native::clock().manualUs += loopUs;
+      loopOnce();
+    }
+    native::clock().manualUs = std::max(native::clock().manualUs, at);
+
+    byte protocol = P_E131;
+    Source s = classify(p, protocol);
+    stats.packets[s]++;
+    if (s == S_NONE) { stats.rejected++; continue; }
+    stats.pendingUs.push_back(micros());
+
+    if (s == S_DDP || s == S_E131 || s == S_ARTNET) { // async listener callback
+      memset(&e131Buffer, 0, sizeof(e131Buffer));
+      memcpy(&e131Buffer, p.data.data(), std::min(p.data.size(), sizeof(e131Buffer)));
+      auto t0 = std::chrono::steady_clock::now();
+      handleE131Packet(&e131Buffer, p.from, protocol);
+      stats.busyNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    } else {                                           // polled in the next loop iteration
+      WiFiUDP &udp = s == S_HYPERION ? rgbUdp : p.port == udpPort2 ? notifier2Udp : notifierUdp;
+      udp.receive(p.data.data(), p.data.size(), p.from);
+    }
+    loopOnce();
+  }
+  for (unsigned i = 0; i < 200000 / loopUs; i++) { native::clock().manualUs += loopUs; loopOnce(); } // let pending frames out
+  const double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+  const double simS  = (native::clock().manualUs - startUs) / 1e6;
+
+  unsigned handled = packets.size() - stats.rejected;
+  printf("%s: %zu packets over %.2f s (simulated, %.2fx), %u LEDs\n", file, packets.size(), simS, speed, leds);
+  for (int s = S_DDP; s <= S_TPM2; s++) if (stats.packets[s]) printf("  %-13s %u packets\n", sourceNames[s], stats.packets[s]);
+  if (stats.rejected) printf("  %-13s %u packets (rejected)\n", sourceNames[S_NONE], stats.rejected);
+  printf("throughput  %.0f packets/s of host processing time (%.1f ms busy, %.1f ms wall)\n", handled / (stats.busyNs / 1e9), stats.busyNs / 1e6, wallS * 1000);
+  printf("frames      %u in capture, %u shown (%.1f fps), %u not shown\n", stats.frames, stats.shows, stats.shows / simS, stats.frames > stats.shows ? stats.frames - stats.shows : 0);
+  unsigned lost = 0, late = 0, repeated = 0;
+  for (auto &kv : stats.seq) { lost += kv.second.lost; late += kv.second.late; repeated += kv.second.repeated; }
+  printf("sequence    %u lost, %u out of order, %u repeated packets\n", lost, late, repeated);
+  std::vector<uint32_t> &l = stats.latencyUs;
+  if (!l.empty())
+    printf("latency     p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms (packet to show(), %zu packets shown, %zu never)\n",
+      percentile(l, 50) / 1000.0, percentile(l, 90) / 1000.0, percentile(l, 99) / 1000.0, *std::max_element(l.begin(), l.end()) / 1000.0,
+      l.size(), stats.pendingUs.size());
+#ifdef WLED_ENABLE_RT_LATENCY
+  const rt_latency_t &rl = getRealtimeLatency(); // WLED's own tracing, last RT_LATENCY_SAMPLES frames
+  const unsigned n = min(rl.count, (uint32_t)RT_LATENCY_SAMPLES);
+  std::vector<uint32_t> ingest(rl.ingest, rl.ingest + n), wait(rl.wait, rl.wait + n), bus(rl.bus, rl.bus + n);
+  if (n) printf("traced      p50/p99 ingest %.1f/%.1f ms, wait %.1f/%.1f ms, bus %.2f/%.2f ms (%u frames, %u merged)\n",
+    percentile(ingest, 50) / 1000.0, percentile(ingest, 99) / 1000.0, percentile(wait, 50) / 1000.0, percentile(wait, 99) / 1000.0,
+    percentile(bus, 50) / 1000.0, percentile(bus, 99) / 1000.0, rl.count, rl.merged);
+#endif
+  return 0;
+}
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""Record or generate realtime UDP traffic for the native replay build (tools/native/replay).
+
+  record    listen on the realtime ports and write every packet received to a capture file;
+            point the sender (xLights, LedFx, Hyperion, ...) at the machine running this
+  generate  write a synthetic stream (moving rainbow) with optional loss, jitter and reordering
+
+Capture file: "WLEDRTC1", then per packet (little endian)
+  uint64 microseconds since the first packet, 4 bytes source IPv4, uint16 destination port,
+  uint16 payload length, payload
+
+examples:
+  python3 realtime_capture.py record show.wrc --universes 1-4
+  python3 realtime_capture.py generate e131.wrc --protocol e131 --leds 1000 --fps 40 --loss 0.01 --jitter 5
+"""
+import argparse
+import random
+import select
+import socket
+import struct
+import time
+import uuid
+
+MAGIC = b"WLEDRTC1"
+DDP_PORT, E131_PORT, ARTNET_PORT, NOTIFIER_PORT, NOTIFIER2_PORT, HYPERION_PORT = 4048, 5568, 6454, 21324, 65506, 19446
+PORTS = (DDP_PORT, E131_PORT, ARTNET_PORT, HYPERION_PORT, NOTIFIER_PORT, NOTIFIER2_PORT)
+CHANNELS_PER_UNIVERSE = 510  # 170 RGB LEDs, as WLED expects in DMX multi RGB mode
+DDP_CHANNELS_PER_PACKET = 1440
+UDP_LEDS_PER_PACKET = 489    # DNRGB
+TPM2_CHANNELS_PER_PACKET = 1386
+
+
+class CaptureWriter:
+    def __init__(self, path):
+        self._f = open(path, "wb")
+        self._f.write(MAGIC)
+        self.count = 0
+
+    def write(self, us, ip, port, data):
+        self._f.write(struct.pack("<Q4sHH", us, socket.inet_aton(ip), port, len(data)) + data)
+        self.count += 1
+
+    def close(self):
+        self._f.close()
+
+
+def parse_universes(arg):
+    out = []
+    for part in (arg or "").split(","):
+        if "-" in part:
+            lo, hi = part.split("-")
+            out.extend(range(int(lo), int(hi) + 1))
+        elif part:
+            out.append(int(part))
+    return out
+
+
+def record(args):
+    socks = []
+    for port in PORTS:
+        s = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        try:
+            s.bind(("", port))
+        except OSError as e:
+            print(f"port {port}: {e}")
+            continue
+        if port == E131_PORT:
+            for u in parse_universes(args.universes):  # E1.31 multicast groups
+                group = socket.inet_aton(f"239.255.{u >> 8}.{u & 0xFF}")
+                s.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, group + socket.inet_aton("0.0.0.0"))
+        socks.append(s)
+    if not socks:
+        return
+
+    out = CaptureWriter(args.file)
+    start = None
+    end = time.monotonic() + args.seconds if args.seconds else None
+    print(f"recording to {args.file}, ctrl-c to stop")
+    try:
+        while end is None or time.monotonic() < end:
+            ready, _, _ = select.select(socks, [], [], 0.5)
+            for s in ready:
+                data, (ip, _) = s.recvfrom(2048)
+                now = time.monotonic_ns() // 1000
+                if start is None:
+                    start = now
+                out.write(now - start, ip, s.getsockname()[1], data)
+    except KeyboardInterrupt:
+        pass
+    out.close()
+    print(f"{out.count} packets")
+
+
+def rainbow(leds, frame, channels):
+    out = bytearray(leds * channels)
+    for i in range(leds):
+        h = (i * 256 // max(leds, 1) + frame * 4) & 0xFF
+        r, g, b = (h * 3, 255 - h * 3, 0) if h < 85 else (255 - (h - 85) * 3, 0, (h - 85) * 3) if h < 170 else (0, (h - 170) * 3, 255 - (h - 170) * 3)
+        out[i * channels:i * channels + 3] = bytes((r, g, b))
+    return bytes(out)
+
+
+def ddp_frame(pixels, seq):
+    """seq: number of packets sent before, DDP numbers packets 1..15"""
+    packets = []
+    for off in range(0, len(pixels), DDP_CHANNELS_PER_PACKET):
+        chunk = pixels[off:off + DDP_CHANNELS_PER_PACKET]
+        flags = 0x40 | (0x01 if off + len(chunk) >= len(pixels) else 0)  # version 1, push on the last packet
+        packets.append((DDP_PORT, struct.pack(">BBBBIH", flags, (seq + len(packets)) % 15 + 1, 0x0B, 1, off, len(chunk)) + chunk))
+    return packets
+
+
+def e131_frame(pixels, seq, universe, cid):
+    packets = []
+    for n, off in enumerate(range(0, len(pixels), CHANNELS_PER_UNIVERSE)):
+        chunk = pixels[off:off + CHANNELS_PER_UNIVERSE]
+        length = 126 + len(chunk)
+        pkt = struct.pack(">HH12sHI16s", 0x0010, 0, b"ASC-E1.17\0\0\0", 0x7000 | (length - 16), 4, cid)
+        pkt += struct.pack(">HI64sBHBBH", 0x7000 | (length - 38), 2, b"WLED replay", 100, 0, seq & 0xFF, 0, universe + n)
+        pkt += struct.pack(">HBBHHHB", 0x7000 | (length - 115), 2, 0xA1, 0, 1, len(chunk) + 1, 0)
+        packets.append((E131_PORT, pkt + chunk))
+    return packets
+
+
+def artnet_frame(pixels, seq, universe):
+    packets = []
+    for n, off in enumerate(range(0, len(pixels), CHANNELS_PER_UNIVERSE)):
+        chunk = pixels[off:off + CHANNELS_PER_UNIVERSE]
+        pkt = b"Art-Net\0" + struct.pack("<H", 0x5000) + struct.pack(">HBB", 14, seq % 255 + 1, 0)
+        packets.append((ARTNET_PORT, pkt + struct.pack("<H", universe + n) + struct.pack(">H", len(chunk)) + chunk))
+    return packets
+
+
+def dnrgb_frame(pixels, timeout):
+    packets = []
+    for start in range(0, len(pixels) // 3, UDP_LEDS_PER_PACKET):
+        chunk = pixels[start * 3:(start + UDP_LEDS_PER_PACKET) * 3]
+        packets.append((NOTIFIER_PORT, bytes((4, timeout, start >> 8, start & 0xFF)) + chunk))
+    return packets
+
+
+def tpm2_frame(pixels):
+    size = min(len(pixels), TPM2_CHANNELS_PER_PACKET)
+    count = (len(pixels) + size - 1) // size
+    packets = []
+    for n in range(count):
+        chunk = pixels[n * size:(n + 1) * size].ljust(size, b"\0")  # WLED expects equally sized packets
+        packets.append((NOTIFIER2_PORT, bytes((0x9C, 0xDA, size >> 8, size & 0xFF, n + 1, count)) + chunk + b"\x36"))
+    return packets
+
+
+def generate(args):
+    rnd = random.Random(args.seed)
+    cid = uuid.uuid4().bytes
+    channels = 3
+    packets = []  # (time us, port, data)
+    sent = 0
+    for frame in range(int(args.fps * args.seconds)):
+        t = frame * 1000000 // args.fps
+        pixels = rainbow(args.leds, frame, channels)
+        if args.protocol == "ddp":      frame_packets = ddp_frame(pixels, sent)
+        elif args.protocol == "e131":   frame_packets = e131_frame(pixels, frame, args.universe, cid)
+        elif args.protocol == "artnet": frame_packets = artnet_frame(pixels, frame, args.universe)
+        elif args.protocol == "dnrgb":  frame_packets = dnrgb_frame(pixels, 2)
+        else:                           frame_packets = tpm2_frame(pixels)
+        sent += len(frame_packets)
+        for i, (port, data) in enumerate(frame_packets):
+            if rnd.random() < args.loss:
+                continue
+            us = t + i * args.spacing + int(rnd.uniform(0, args.jitter * 1000))
+            if rnd.random() < args.reorder:
+                us += args.spacing * 2  # overtaken by the next packet
+            packets.append((us, port, data))
+    packets.sort(key=lambda p: p[0])
+
+    out = CaptureWriter(args.file)
+    for us, port, data in packets:
+        out.write(us, args.source, port, data)
+    out.close()
+    print(f"{out.count} packets, {args.protocol}, {args.leds} LEDs, {args.fps} fps, {args.seconds} s")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    rec = sub.add_parser("record", help="capture realtime packets from the network")
+    rec.add_argument("file")
+    rec.add_argument("--universes", help="E1.31 multicast universes to join, e.g. 1-4,10")
+    rec.add_argument("--seconds", type=float, default=0, help="stop after this time (default: ctrl-c)")
+    gen = sub.add_parser("generate", help="write a synthetic stream")
+    gen.add_argument("file")
+    gen.add_argument("--protocol", choices=("ddp", "e131", "artnet", "dnrgb", "tpm2"), default="ddp")
+    gen.add_argument("--leds", type=int, default=1000)
+    gen.add_argument("--fps", type=int, default=40)
+    gen.add_argument("--seconds", type=float, default=10)
+    gen.add_argument("--universe", type=int, default=1, help="first E1.31/Art-Net universe")
+    gen.add_argument("--spacing", type=int, default=100, help="microseconds between the packets of a frame")
+    gen.add_argument("--loss", type=float, default=0, help="probability of dropping a packet")
+    gen.add_argument("--jitter", type=float, default=0, help="maximum random delay per packet in ms")
+    gen.add_argument("--reorder", type=float, default=0, help="probability of a packet arriving late")
+    gen.add_argument("--source", default="192.168.4.2", help="source address recorded for the packets")
+    gen.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+    record(args) if args.command == "record" else generate(args)
@@ -72,6 +72,11 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #endif
 #define FPS_CALC_SHIFT 7 // bit shift for fixed point math
 
+// frame time statistics (all times in microseconds)
+#define FRAME_STAT_WINDOW  256 // min/max roll over every this many samples (previous window is kept, so they always cover 256-512 samples)
+#define FRAME_STAT_AVG     4   // bit shift for exponential moving average (1/16 weight of a new sample)
+#define FRAME_STAT_BUCKETS 8   // histogram buckets, upper bounds: 256us, 512us, 1ms, 2ms, 4ms, 8ms, 16ms, more
+
 /* each segment uses 82 bytes of SRAM memory, so if you're application fails because of
   insufficient memory, decreasing MAX_NUM_SEGMENTS may help */
 #ifdef ESP8266
@@ -90,6 +95,18 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
   assuming each segment uses the same amount of data. 256 for ESP8266, 640 for ESP32. */
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / strip.getMaxSegments())
 
+/* How many pixels (4 bytes each) all segment buffers combined may hold (only used if useSegmentBuffers is enabled).
+  Segments that do not fit draw directly into the strip buffer. */
+#ifndef MAX_SEGMENT_PIXELS
+  #define MAX_SEGMENT_PIXELS (2*MAX_LEDS)
+#endif
+
+/* Capacity (in pixels) of the scratch pool used by fade transitions to render the outgoing effect off-screen.
+  Transitions that do not fit fall back to drawing the old effect over the new one. */
+#ifndef MAX_XFADE_PIXELS
+  #define MAX_XFADE_PIXELS (MAX_SEGMENT_DATA/sizeof(uint32_t))
+#endif
+
 #define NUM_COLORS       3 /* number of colors per segment */
 #define SEGMENT          strip._segments[strip.getCurrSegmentId()]
 #define SEGENV           strip._segments[strip.getCurrSegmentId()]
@@ -379,6 +396,18 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define BLEND_STYLE_PUSH_MASK       0x10
 #define BLEND_STYLE_COUNT           18
 
+// segment layer blend modes, used when compositing segment buffers (useSegmentBuffers)
+#define SEG_BLEND_NORMAL            0x00  // segment replaces underlying pixels
+#define SEG_BLEND_ADD               0x01
+#define SEG_BLEND_SUBTRACT          0x02  // underlying minus segment
+#define SEG_BLEND_MULTIPLY          0x03
+#define SEG_BLEND_LIGHTEN           0x04  // per channel maximum
+#define SEG_BLEND_DARKEN            0x05  // per channel minimum
+#define SEG_BLEND_SCREEN            0x06
+#define SEG_BLEND_AVERAGE           0x07
+#define SEG_BLEND_DIFFERENCE        0x08
+#define SEG_BLEND_COUNT             9
+
 
 typedef enum mapping1D2D {
   M12_Pixels = 0,
@@ -417,6 +446,7 @@ typedef struct Segment {
     };
     uint8_t  grouping, spacing;
     uint8_t  opacity;
+    uint8_t  blendMode;           // layer blend mode (SEG_BLEND_*), only with segment buffers
     uint32_t colors[NUM_COLORS];
     uint8_t  cct;                 //0==1900K, 255==10091K
     uint8_t  custom1, custom2;    // custom FX parameters/sliders
@@ -489,8 +519,14 @@ typedef struct Segment {
     static uint16_t _lastPaletteChange;       // last random palette change time in millis()/1000
     static uint16_t _lastPaletteBlend;        // blend palette according to set Transition Delay in millis()%0xFFFF
     static uint16_t _transitionprogress;      // current transition progress 0 - 0xFFFF
+    static unsigned _usedSegmentPixels;       // number of pixels held by all segment buffers
     #ifndef WLED_DISABLE_MODE_BLEND
     static bool          _modeBlend;          // mode/effect blending semaphore
+    static bool          _crossfade;          // old effect is rendering into crossfade buffer
+    static uint32_t     *_xfPool;             // scratch pool for crossfade buffers (allocated on demand)
+    static unsigned      _xfPoolSize;         // pool capacity in pixels
+    static unsigned      _xfPoolUsed;         // pixels handed out (reclaimed when the last crossfade ends)
+    static unsigned      _xfPoolUsers;        // number of transitions using the pool
     // clipping
     static uint16_t _clipStart, _clipStop;
     static uint8_t  _clipStartY, _clipStopY;
@@ -512,15 +548,42 @@ typedef struct Segment {
       unsigned long _start;       // must accommodate millis()
       uint16_t      _dur;
       // -> here is one byte of padding
+      #ifndef WLED_DISABLE_MODE_BLEND
+      uint32_t     *_xfPixels;    // old effect output (fade transition), part of crossfade pool
+      unsigned      _xfLen;       // pixels in _xfPixels
+      uint16_t      _xfWidth;     // virtual width (row length) of _xfPixels
+      uint16_t      _xfHeight;    // virtual height of _xfPixels
+      #endif
       Transition(uint16_t dur=750)
         : _palT(CRGBPalette16(CRGB::Black))
         , _prevPaletteBlends(0)
         , _start(millis())
         , _dur(dur)
+        #ifndef WLED_DISABLE_MODE_BLEND
+        , _xfPixels(nullptr)
+        , _xfLen(0)
+        , _xfWidth(0)
+        , _xfHeight(0)
+        #endif
       {}
     } *_t;
 
-    [[gnu::hot]] void _setPixelColorXY_raw(const int& x, const int& y, uint32_t& col) const; // set pixel without mapping (internal use only)
+    // segment buffer (only if useSegmentBuffers is enabled): effect output in virtual pixels at full precision
+    // (not brightness scaled); composite() maps it onto the strip once per frame
+    uint32_t *_pixels;
+    unsigned  _pixelsLen;     // number of pixels in _pixels
+    uint16_t  _pixelsWidth;   // virtual width (row length) the buffer was allocated for
+    uint16_t  _pixelsHeight;  // virtual height the buffer was allocated for
+    uint8_t   _pixelsBri;     // brightness applied in composite()
+
+    bool allocatePixels();    // (re)allocates segment buffer for current virtual dimensions (set in beginDraw())
+    bool _isXYBuffer() const; // segment buffer is addressed by setPixelColorXY() (2D or 1D segment on a matrix)
+    uint32_t *_spanPixels(unsigned cols, unsigned rows, unsigned &stride) const; // segment buffer if whole-segment operations can work on it directly
+    void _expandBuffer(const uint32_t *buf, unsigned w, unsigned h, unsigned len, uint8_t bri, uint8_t bm) const; // expand virtual pixels of buf onto strip
+
+    [[gnu::hot]] void _expandPixel(int i, uint32_t col, uint8_t bm) const; // set physical pixels of virtual pixel i (grouping, spacing, reverse, mirror, offset)
+    [[gnu::hot]] void _expandPixelXY(int x, int y, uint32_t col, int vW, int vH, uint8_t bm) const; // same for 2D (reverse, transpose, grouping)
+    [[gnu::hot]] void _setPixelColorXY_raw(const int& x, const int& y, uint32_t& col, uint8_t bm = SEG_BLEND_NORMAL) const; // set pixel without mapping (internal use only)
 
   public:
 
@@ -536,6 +599,7 @@ typedef struct Segment {
       grouping(1),
       spacing(0),
       opacity(255),
+      blendMode(SEG_BLEND_NORMAL),
       colors{DEFAULT_COLOR,BLACK,BLACK},
       cct(127),
       custom1(DEFAULT_C1),
@@ -556,7 +620,12 @@ typedef struct Segment {
       _capabilities(0),
       _default_palette(0),
       _dataLen(0),
-      _t(nullptr)
+      _t(nullptr),
+      _pixels(nullptr),
+      _pixelsLen(0),
+      _pixelsWidth(0),
+      _pixelsHeight(0),
+      _pixelsBri(255)
     {
       #ifdef WLED_DEBUG
       //Serial.printf("-- Creating segment: %p\n", this);
@@ -581,13 +650,14 @@ typedef struct Segment {
       if (name) { free(name); name = nullptr; }
       stopTransition();
       deallocateData();
+      deallocatePixels();
     }
 
     Segment& operator= (const Segment &orig); // copy assignment
     Segment& operator= (Segment &&orig) noexcept; // move assignment
 
 #ifdef WLED_DEBUG
-    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0); }
+    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + _pixelsLen*sizeof(uint32_t); }
 #endif
 
     inline bool     getOption(uint8_t n) const { return ((options >> n) & 0x01); }
@@ -607,10 +677,13 @@ typedef struct Segment {
     inline Segment &setName(const String &name) { return setName(name.c_str()); }
 
     inline static unsigned getUsedSegmentData()            { return Segment::_usedSegmentData; }
+    inline static unsigned getUsedSegmentPixels()          { return Segment::_usedSegmentPixels; }
     inline static void     addUsedSegmentData(int len)     { Segment::_usedSegmentData += len; }
     #ifndef WLED_DISABLE_MODE_BLEND
     inline static void     modeBlend(bool blend)           { _modeBlend = blend; }
     inline static bool     getmodeBlend(void)              { return _modeBlend; }
+    inline static unsigned getXfadePoolSize()              { return Segment::_xfPoolSize; }
+    inline static unsigned getXfadePoolUsed()              { return Segment::_xfPoolUsed; }
     #endif
     inline static unsigned vLength()                       { return Segment::_vLength; }
     inline static unsigned vWidth()                        { return Segment::_vWidth; }
@@ -637,6 +710,9 @@ typedef struct Segment {
     bool allocateData(size_t len);  // allocates effect data buffer in heap and clears it
     void deallocateData();          // deallocates (frees) effect data buffer from heap
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
+    void deallocatePixels();        // releases segment buffer (segment will draw directly into strip until next beginDraw())
+    inline bool hasPixelBuffer() const { return _pixels != nullptr; }
+    void composite(bool useBlendModes = true) const; // writes segment buffer into strip (brightness, mapping and layer blend mode)
     /**
       * Flags that before the next effect is calculated,
       * the internal segment state should be reset.
@@ -652,6 +728,11 @@ typedef struct Segment {
     #ifndef WLED_DISABLE_MODE_BLEND
     void     swapSegenv(tmpsegd_t &tmpSegD);    // copies segment data into specifed buffer, if buffer is not a transition buffer, segment data is overwritten from transition buffer
     void     restoreSegenv(const tmpsegd_t &tmpSegD); // restores segment data from buffer, if buffer is not transition buffer, changed values are copied to transition buffer
+    bool     allocateCrossfade();               // old effect only: gets crossfade buffer from pool and fills it with current segment content
+    void     releaseCrossfade();                // returns crossfade buffer to pool
+    bool     beginCrossfade();                  // old effect only: redirects drawing into crossfade buffer, false if there is none
+    void     endCrossfade();                    // restores drawing target and blends crossfade buffer over new effect by progress()
+    inline bool hasCrossfade() const { return isInTransition() && _t->_xfPixels; }
     #endif
     [[gnu::hot]] void updateTransitionProgress();            // set current progression of transition
     inline uint16_t progress() const { return Segment::_transitionprogress; }  // transition progression between 0-65535
@@ -789,6 +870,64 @@ typedef struct Segment {
 } segment;
 //static int segSize = sizeof(Segment);
 
+// rolling min/avg/max of a measured duration (in us)
+typedef struct FrameTime {
+  uint32_t last;
+  uint32_t avg;     // fixed point, see FRAME_STAT_AVG
+  uint32_t minPrev; // min & max of previous window
+  uint32_t maxPrev;
+  uint32_t minCur;  // min & max of current window
+  uint32_t maxCur;
+  uint16_t samples; // samples in current window
+
+  FrameTime() { reset(); }
+  void reset();
+  void add(uint32_t us);
+  inline uint32_t getMin() const { uint32_t m = std::min(minPrev, minCur); return m == UINT32_MAX ? 0 : m; }
+  inline uint32_t getAvg() const { return avg >> FRAME_STAT_AVG; }
+  inline uint32_t getMax() const { return std::max(maxPrev, maxCur); }
+} frame_time_t;
+
+// as above with sample count and histogram
+typedef struct FrameStat : FrameTime {
+  uint32_t count;
+  uint32_t hist[FRAME_STAT_BUCKETS];
+
+  FrameStat() { reset(); }
+  void reset();
+  void add(uint32_t us);
+  static inline uint32_t bucketLimit(unsigned b) { return b < FRAME_STAT_BUCKETS-1 ? 256U << b : UINT32_MAX; } // upper bound of histogram bucket
+} frame_stat_t;
+
+// where strip.service() and strip.show() spend their time
+typedef struct FrameStats {
+  frame_stat_t frame;   // whole strip.service() call that produced a frame
+  frame_stat_t fx;      // effect functions of all segments
+  frame_stat_t blend;   // old effect functions rendered during effect transitions
+  frame_stat_t show;    // strip.show() (overlay + BusManager::show())
+  frame_stat_t bus;     // BusManager::show()
+  frame_stat_t overlay; // pre-show callback (usermod/clock overlays)
+  frame_stat_t comp;    // compositing segment buffers into the strip buffer (useSegmentBuffers)
+  frame_stat_t xfade;   // capturing and blending crossfade buffers (fade transitions), on top of blend
+  void reset() { frame.reset(); fx.reset(); blend.reset(); show.reset(); bus.reset(); overlay.reset(); comp.reset(); xfade.reset(); }
+} frame_stats_t;
+
+// per segment effect timing
+typedef struct SegmentTime {
+  frame_time_t fx;    // current effect function
+  frame_time_t blend; // previous effect function while in transition
+  uint8_t      mode;  // effect the times belong to (reset on change)
+  SegmentTime() : mode(0) {}
+} segment_time_t;
+
+// ledmap run: logical pixels from first up to the next run's first are mapped to physical pixels start, start+step, ...
+// (0xFFFF with step 0 for unused positions); maps made of long linear runs are kept as sorted runs instead of a table
+typedef struct MappingRun {
+  uint16_t first;
+  uint16_t start;
+  int16_t  step;
+} mapping_run_t;
+
 // main "strip" class
 class WS2812FX {  // 96 bytes
   typedef uint16_t (*mode_ptr)(); // pointer to mode function
@@ -808,6 +947,8 @@ class WS2812FX {  // 96 bytes
       paletteBlend(0),
       now(millis()),
       timebase(0),
+      clockOffset(0),
+      clockLocked(false),
       isMatrix(false),
 #ifndef WLED_DISABLE_2D
       panels(1),
@@ -834,9 +975,14 @@ class WS2812FX {  // 96 bytes
       _modeCount(MODE_COUNT),
       _callback(nullptr),
       customMappingTable(nullptr),
+      customMappingRuns(nullptr),
       customMappingSize(0),
+      customMappingRunCount(0),
+      _mappingCursor(0),
+      _pixels(nullptr),
       _lastShow(0),
       _lastServiceShow(0),
+      _lastFrameSlot(0),
       _segment_index(0),
       _mainSegment(0)
     {
@@ -849,6 +995,8 @@ class WS2812FX {  // 96 bytes
 
     ~WS2812FX() {
       if (customMappingTable) free(customMappingTable);
+      if (customMappingRuns) free(customMappingRuns);
+      if (_pixels) free(_pixels);
       _mode.clear();
       _modeData.clear();
       _segments.clear();
@@ -875,11 +1023,13 @@ class WS2812FX {  // 96 bytes
       makeAutoSegments(bool forceReset = false),  // will create segments based on configured outputs
       fixInvalidSegments(),                       // fixes incorrect segment configuration
       setPixelColor(unsigned i, uint32_t c) const,      // paints absolute strip pixel with index n and color c
-      show(),                                     // initiates LED output
+      setPixelColors(unsigned i, const uint32_t *c, unsigned len) const, // paints len consecutive absolute strip pixels starting at i
+      show(),                                     // initiates LED output (writes strip buffer to busses if used)
       setTargetFps(unsigned fps),
       setupEffectData();                          // add default effects to the list; defined in FX.cpp
 
-    inline void resetTimebase()           { timebase = 0UL - millis(); }
+    inline void resetTimebase()           { timebase = 0UL - clockMillis(); }
+    inline void resetFrameStats()         { _frameStats.reset(); _segmentStats.clear(); }
     inline void restartRuntime()          { for (Segment &seg : _segments) { seg.markForReset().resetIfRequired(); } }
     inline void setTransitionMode(bool t) { for (Segment &seg : _segments) seg.startTransition(t ? _transitionDur : 0); }
     inline void setPixelColor(unsigned n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) const { setPixelColor(n, RGBW32(r,g,b,w)); }
@@ -899,6 +1049,7 @@ class WS2812FX {  // 96 bytes
       deserializeMap(unsigned n = 0);
 
     inline bool isUpdating() const           { return !BusManager::canAllShow(); } // return true if the strip is being sent pixel updates
+    inline bool hasPixelBuffer() const       { return _pixels != nullptr; }     // returns true if segments are composited into a strip buffer (useSegmentBuffers)
     inline bool isServicing() const          { return _isServicing; }           // returns true if strip.service() is executing
     inline bool hasWhiteChannel() const      { return _hasWhiteChannel; }       // returns true if strip contains separate white chanel
     inline bool isOffRefreshRequired() const { return _isOffRefreshRequired; }  // returns true if strip requires regular updates (i.e. TM1814 chipset)
@@ -932,15 +1083,27 @@ class WS2812FX {  // 96 bytes
     inline uint16_t getLength() const       { return _length; }           // returns actual amount of LEDs on a strip (2D matrix may have less LEDs than W*H)
     inline uint16_t getTransition() const   { return _transitionDur; }    // returns currently set transition time (in ms)
     inline uint16_t getMappedPixelIndex(uint16_t index) const {           // convert logical address to physical
-      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) index = customMappingTable[index];
+      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) {
+        if (customMappingTable) index = customMappingTable[index];
+        else {
+          const mapping_run_t &run = customMappingRuns[findMappingRun(index)];
+          index = run.start + (index - run.first) * run.step;
+        }
+      }
       return index;
     };
 
     unsigned long now, timebase;
+    long clockOffset;  // network clock - millis() (ms), maintained by clock sync
+    bool clockLocked;  // clock follows the network clock: render on the shared frame grid
+    inline unsigned long clockMillis() const { return millis() + clockOffset; } // millis() on the network clock (equals millis() without clock sync)
     uint32_t getPixelColor(unsigned i) const;
 
     inline uint32_t getLastShow() const   { return _lastShow; }           // returns millis() timestamp of last strip.show() call
 
+    inline const frame_stats_t& getFrameStats() const                      { return _frameStats; }   // returns frame time statistics
+    inline const std::vector<segment_time_t>& getSegmentStats() const      { return _segmentStats; } // returns per segment effect time statistics (indexed by segment id)
+
     const char *getModeData(unsigned id = 0) const { return (id && id < _modeCount) ? _modeData[id] : PSTR("Solid"); }
     inline const char **getModeDataSrc()  { return &(_modeData[0]); } // vectors use arrays for underlying data
 
@@ -995,6 +1158,8 @@ class WS2812FX {  // 96 bytes
   // end 2D support
 
     void loadCustomPalettes(); // loads custom palettes from JSON
+    static void invalidateLedmapCache();                                 // drops cached ledmaps (a ledmap file changed)
+    static bool getBinaryLedmapName(unsigned n, char *name, size_t len); // name stored in ledmap.lmb/ledmapN.lmb
     std::vector<CRGBPalette16> customPalettes; // TODO: move custom palettes out of WS2812FX class
 
     struct {
@@ -1031,11 +1196,28 @@ class WS2812FX {  // 96 bytes
 
     show_callback _callback;
 
-    uint16_t* customMappingTable;
-    uint16_t  customMappingSize;
+    uint16_t*      customMappingTable; // either a table entry per logical pixel
+    mapping_run_t* customMappingRuns;  // or runs (see mapping_run_t) and an end marker, the other one is nullptr
+    uint16_t       customMappingSize;
+    uint16_t       customMappingRunCount;
+    mutable uint16_t _mappingCursor;   // run of the last lookup, pixels are mostly written in order
+
+    inline unsigned findMappingRun(unsigned index) const {  // run containing logical pixel index (< customMappingSize)
+      const mapping_run_t *run = customMappingRuns + _mappingCursor;
+      return index - run[0].first < unsigned(run[1].first - run[0].first) ? _mappingCursor : searchMappingRun(index);
+    }
+    unsigned searchMappingRun(unsigned index) const;
+    void clearMapping();   // releases the ledmap (table or runs)
+    void compactMapping(); // replaces the table with runs if they are much smaller
+
+    uint32_t* _pixels;  // strip buffer (physical pixel order) segments are composited into, only with useSegmentBuffers
 
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
+    unsigned long _lastFrameSlot;  // network clock frame slot last rendered (clockLocked)
+
+    frame_stats_t               _frameStats;
+    std::vector<segment_time_t> _segmentStats;
 
     uint8_t _segment_index;
     uint8_t _mainSegment;
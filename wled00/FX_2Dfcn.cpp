@@ -48,9 +48,8 @@ void WS2812FX::setUpMatrix() {
       return;
     }
 
-    customMappingSize = 0; // prevent use of mapping if anything goes wrong
+    clearMapping(); // prevent use of mapping if anything goes wrong
 
-    if (customMappingTable) free(customMappingTable);
     customMappingTable = static_cast<uint16_t*>(malloc(sizeof(uint16_t)*getLengthTotal()));
 
     if (customMappingTable) {
@@ -123,6 +122,7 @@ void WS2812FX::setUpMatrix() {
       }
       DEBUG_PRINTLN();
       #endif
+      compactMapping();
     } else { // memory allocation error
       DEBUG_PRINTLN(F("ERROR 2D LED map allocation error."));
       isMatrix = false;
@@ -145,8 +145,14 @@ void WS2812FX::setUpMatrix() {
 
 #ifndef WLED_DISABLE_2D
 
+// writes strip pixel, blending with its current content according to layer blend mode (each mirrored pixel separately)
+static inline void setStripPixelXY(int x, int y, uint32_t col, uint8_t bm) {
+  if (bm != SEG_BLEND_NORMAL) col = color_blend_mode(strip.getPixelColorXY(x, y), col, bm);
+  strip.setPixelColorXY(x, y, col);
+}
+
 // raw setColor function without checks (checks are done in setPixelColorXY())
-void IRAM_ATTR_YN Segment::_setPixelColorXY_raw(const int& x, const int& y, uint32_t& col) const
+void IRAM_ATTR_YN Segment::_setPixelColorXY_raw(const int& x, const int& y, uint32_t& col, uint8_t bm) const
 {
   const int baseX = start + x;
   const int baseY = startY + y;
@@ -154,15 +160,15 @@ void IRAM_ATTR_YN Segment::_setPixelColorXY_raw(const int& x, const int& y, uint
   // if blending modes, blend with underlying pixel
   if (_modeBlend && blendingStyle == BLEND_STYLE_FADE) col = color_blend16(strip.getPixelColorXY(baseX, baseY), col, 0xFFFFU - progress());
 #endif
-  strip.setPixelColorXY(baseX, baseY, col);
+  setStripPixelXY(baseX, baseY, col, bm);
 
   // Apply mirroring
   if (mirror || mirror_y) {
     const int mirrorX = start + width() - x - 1;
     const int mirrorY = startY + height() - y - 1;
-    if (mirror) strip.setPixelColorXY(transpose ? baseX : mirrorX, transpose ? mirrorY : baseY, col);
-    if (mirror_y) strip.setPixelColorXY(transpose ? mirrorX : baseX, transpose ? baseY : mirrorY, col);
-    if (mirror && mirror_y) strip.setPixelColorXY(mirrorX, mirrorY, col);
+    if (mirror) setStripPixelXY(transpose ? baseX : mirrorX, transpose ? mirrorY : baseY, col, bm);
+    if (mirror_y) setStripPixelXY(transpose ? mirrorX : baseX, transpose ? baseY : mirrorY, col, bm);
+    if (mirror && mirror_y) setStripPixelXY(mirrorX, mirrorY, col, bm);
   }
 }
 
@@ -221,6 +227,23 @@ void IRAM_ATTR_YN Segment::setPixelColorXY(int x, int y, uint32_t col) const
   // if color is unscaled
   if (!_colorScaled) col = color_fade(col, _segBri);
 
+  if (_pixels) { // segment buffer: mapping to physical pixels is done in composite()
+    const unsigned idx = y * _pixelsWidth + x;
+    if (x < _pixelsWidth && idx < _pixelsLen) {
+#ifndef WLED_DISABLE_MODE_BLEND
+      // _modeBlend==true -> old effect (unless drawing into its own crossfade buffer)
+      if (_modeBlend && !_crossfade && blendingStyle == BLEND_STYLE_FADE) col = color_blend16(_pixels[idx], col, 0xFFFFU - progress());
+#endif
+      _pixels[idx] = col;
+    }
+    return;
+  }
+  _expandPixelXY(x, y, col, vW, vH, SEG_BLEND_NORMAL);
+}
+
+// expand pixel (taking into account reverse, transpose and grouping); mirroring is done in _setPixelColorXY_raw()
+void IRAM_ATTR_YN Segment::_expandPixelXY(int x, int y, uint32_t col, int vW, int vH, uint8_t bm) const
+{
   if (reverse  ) x = vW - x - 1;
   if (reverse_y) y = vH - y - 1;
   if (transpose) { std::swap(x,y); } // swap X & Y if segment transposed
@@ -235,11 +258,11 @@ void IRAM_ATTR_YN Segment::setPixelColorXY(int x, int y, uint32_t col) const
     const int maxX = std::min(x + grouping, W);
     for (int yY = y; yY < maxY; yY++) {
       for (int xX = x; xX < maxX; xX++) {
-        _setPixelColorXY_raw(xX, yY, col);
+        _setPixelColorXY_raw(xX, yY, col, bm);
       }
     }
   } else {
-    _setPixelColorXY_raw(x, y, col);
+    _setPixelColorXY_raw(x, y, col, bm);
   }
 }
 
@@ -307,6 +330,11 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColorXY(int x, int y) const {
 
   if (x >= vW || y >= vH || x<0 || y<0 || isPixelXYClipped(x,y)) return 0;  // if pixel would fall out of virtual segment just exit
 
+  if (_pixels) {
+    const unsigned idx = y * _pixelsWidth + x;
+    return x < _pixelsWidth && idx < _pixelsLen ? _pixels[idx] : 0;
+  }
+
   if (reverse  ) x = vW - x - 1;
   if (reverse_y) y = vH - y - 1;
   if (transpose) { std::swap(x,y); } // swap X & Y if segment transposed
@@ -321,6 +349,12 @@ void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) {
   if (!isActive()) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
+  unsigned stride;
+  if (uint32_t *px = _spanPixels(cols, rows, stride)) { // blur rows and columns directly in the segment buffer
+    if (blur_x) for (unsigned row = 0; row < rows; row++) color_blur_span(px + row * stride, cols, 1, smear ? 255 : 255 - blur_x, blur_x >> 1);
+    if (blur_y) for (unsigned col = 0; col < cols; col++) color_blur_span(px + col, rows, stride, smear ? 255 : 255 - blur_y, blur_y >> 1);
+    return;
+  }
   uint32_t lastnew;   // not necessary to initialize lastnew and last, as both will be initialized by the first loop iteration
   uint32_t last;
   if (blur_x) {
@@ -68,6 +68,7 @@ static constexpr bool validatePinsAndTypes(const unsigned* types, unsigned numTy
 // Segment class implementation
 ///////////////////////////////////////////////////////////////////////////////
 unsigned      Segment::_usedSegmentData   = 0U; // amount of RAM all segments use for their data[]
+unsigned      Segment::_usedSegmentPixels = 0U; // amount of pixels all segment buffers hold
 uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
 uint16_t      Segment::maxHeight          = 1;
 unsigned      Segment::_vLength           = 0;
@@ -85,6 +86,11 @@ uint16_t      Segment::_transitionprogress  = 0xFFFF;
 
 #ifndef WLED_DISABLE_MODE_BLEND
 bool Segment::_modeBlend = false;
+bool      Segment::_crossfade   = false;
+uint32_t *Segment::_xfPool      = nullptr;
+unsigned  Segment::_xfPoolSize  = 0;
+unsigned  Segment::_xfPoolUsed  = 0;
+unsigned  Segment::_xfPoolUsers = 0;
 uint16_t Segment::_clipStart = 0;
 uint16_t Segment::_clipStop = 0;
 uint8_t  Segment::_clipStartY = 0;
@@ -99,6 +105,8 @@ Segment::Segment(const Segment &orig) {
   name = nullptr;
   data = nullptr;
   _dataLen = 0;
+  _pixels = nullptr; // segment buffer is not copied, it is re-allocated on next beginDraw()
+  _pixelsLen = 0;
   if (orig.name) { name = static_cast<char*>(malloc(strlen(orig.name)+1)); if (name) strcpy(name, orig.name); }
   if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
 }
@@ -111,6 +119,8 @@ Segment::Segment(Segment &&orig) noexcept {
   orig.name = nullptr;
   orig.data = nullptr;
   orig._dataLen = 0;
+  orig._pixels = nullptr;
+  orig._pixelsLen = 0;
 }
 
 // copy assignment
@@ -121,11 +131,14 @@ Segment& Segment::operator= (const Segment &orig) {
     if (name) { free(name); name = nullptr; }
     stopTransition();
     deallocateData();
+    deallocatePixels();
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     // erase pointers to allocated data
     data = nullptr;
     _dataLen = 0;
+    _pixels = nullptr;
+    _pixelsLen = 0;
     // copy source data
     if (orig.name) { name = static_cast<char*>(malloc(strlen(orig.name)+1)); if (name) strcpy(name, orig.name); }
     if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
@@ -140,10 +153,13 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     if (name) { free(name); name = nullptr; } // free old name
     stopTransition();
     deallocateData(); // free old runtime data
+    deallocatePixels();
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
+    orig._pixels = nullptr;
+    orig._pixelsLen = 0;
     orig._t   = nullptr; // old segment cannot be in transition
   }
   return *this;
@@ -187,6 +203,37 @@ void IRAM_ATTR_YN Segment::deallocateData() {
   _dataLen = 0;
 }
 
+// allocates segment buffer for the virtual dimensions calculated in beginDraw()
+// existing buffer is kept if dimensions did not change so effects can read back their previous frame
+bool Segment::allocatePixels() {
+  const unsigned w   = _vWidth;
+  const unsigned h   = _vHeight;
+  const unsigned len = std::max(w * h, _vLength); // 1D expansion into 2D (i.e. pinwheel) may use more than W*H
+  if (_pixels && _pixelsLen == len && _pixelsWidth == w) return true;
+  deallocatePixels();
+  if (len == 0 || w > UINT16_MAX || h > UINT16_MAX) return false;
+  if (_usedSegmentPixels + len > MAX_SEGMENT_PIXELS) {
+    DEBUG_PRINTF_P(PSTR("!!! Segment buffer does not fit: %u/%u !!!\n"), len, _usedSegmentPixels);
+    return false; // segment will draw directly into strip
+  }
+  _pixels = static_cast<uint32_t*>(calloc(len, sizeof(uint32_t)));
+  if (!_pixels) return false;
+  _pixelsLen    = len;
+  _pixelsWidth  = w;
+  _pixelsHeight = h;
+  _usedSegmentPixels += len;
+  return true;
+}
+
+void Segment::deallocatePixels() {
+  if (_pixels) {
+    free(_pixels);
+    _usedSegmentPixels -= std::min(_pixelsLen, _usedSegmentPixels);
+  }
+  _pixels    = nullptr;
+  _pixelsLen = 0;
+}
+
 /**
   * If reset of this segment was requested, clears runtime
   * settings of this segment.
@@ -298,6 +345,7 @@ void Segment::stopTransition() {
   if (isInTransition()) {
     //DEBUG_PRINTF_P(PSTR("-- Stopping transition: %p\n"), this);
     #ifndef WLED_DISABLE_MODE_BLEND
+    releaseCrossfade();
     if (_t->_segT._dataT && _t->_segT._dataLenT > 0) {
       //DEBUG_PRINTF_P(PSTR("--  Released duplicate data (%d) for %p: %p\n"), _t->_segT._dataLenT, this, _t->_segT._dataT);
       free(_t->_segT._dataT);
@@ -389,6 +437,94 @@ void Segment::restoreSegenv(const tmpsegd_t &tmpSeg) {
   data      = tmpSeg._dataT;
   _dataLen  = tmpSeg._dataLenT;
 }
+
+/*
+ * Fade transitions render the old effect into its own (crossfade) buffer instead of over the new effect, so that
+ * effects reading back their previous frame or not touching every pixel are blended correctly per pixel.
+ * Buffers are handed out from a pool (bump allocated, capped at MAX_XFADE_PIXELS) which is sized to the segments
+ * in transition when first needed and released when the last of them ends.
+ * Must be called with old effect environment set up (swapSegenv() + beginDraw()) before the new effect draws.
+ */
+bool Segment::allocateCrossfade() {
+  if (!isInTransition()) return false;
+  const unsigned w   = _vWidth;
+  const unsigned h   = _vHeight;
+  const unsigned len = std::max(w * h, _vLength);
+  if (_t->_xfPixels) return _t->_xfLen >= len && _t->_xfWidth == w;
+  if (len == 0 || w > UINT16_MAX || h > UINT16_MAX) return false;
+  if (!_xfPool) {
+    // size pool for all segments currently in transition (they usually start together)
+    unsigned demand = 0;
+    for (unsigned i = 0; i < strip.getSegmentsNum(); i++) {
+      const Segment &seg = strip.getSegment(i);
+      if (seg.isActive() && seg.isInTransition()) demand += std::max(seg.virtualWidth() * seg.virtualHeight(), (unsigned)seg.virtualLength());
+    }
+    _xfPoolSize = std::min(std::max(demand, len), (unsigned)MAX_XFADE_PIXELS);
+    _xfPool = static_cast<uint32_t*>(malloc(_xfPoolSize * sizeof(uint32_t)));
+    _xfPoolUsed = 0;
+    if (!_xfPool) { _xfPoolSize = 0; return false; }
+  }
+  if (_xfPoolUsed + len > _xfPoolSize) {
+    DEBUG_PRINTF_P(PSTR("!!! Crossfade buffer does not fit: %u/%u !!!\n"), len, _xfPoolSize - _xfPoolUsed);
+    return false; // old effect will draw over new effect
+  }
+  _t->_xfPixels = _xfPool + _xfPoolUsed;
+  _t->_xfLen    = len;
+  _t->_xfWidth  = w;
+  _t->_xfHeight = h;
+  _xfPoolUsed  += len;
+  _xfPoolUsers++;
+  // start with what old effect has drawn so far (effects may build on their previous frame)
+  if (_isXYBuffer()) {
+    for (unsigned y = 0; y < h; y++) for (unsigned x = 0; x < w; x++) _t->_xfPixels[y * w + x] = getPixelColorXY(int(x), int(y));
+    for (unsigned i = w * h; i < len; i++) _t->_xfPixels[i] = BLACK;
+  } else {
+    for (unsigned i = 0; i < len; i++) _t->_xfPixels[i] = getPixelColor(int(i));
+  }
+  return true;
+}
+
+void Segment::releaseCrossfade() {
+  if (!isInTransition() || !_t->_xfPixels) return;
+  _t->_xfPixels = nullptr;
+  _t->_xfLen    = 0;
+  if (_xfPoolUsers > 0 && --_xfPoolUsers == 0) {
+    free(_xfPool);
+    _xfPool     = nullptr;
+    _xfPoolSize = 0;
+    _xfPoolUsed = 0;
+  }
+}
+
+bool Segment::beginCrossfade() {
+  if (!hasCrossfade() || _t->_xfWidth != _vWidth || _t->_xfLen < std::max(_vWidth * _vHeight, _vLength)) return false;
+  // swap drawing target: get/setPixelColor() use segment buffer code path
+  std::swap(_pixels, _t->_xfPixels);
+  std::swap(_pixelsLen, _t->_xfLen);
+  std::swap(_pixelsWidth, _t->_xfWidth);
+  std::swap(_pixelsHeight, _t->_xfHeight);
+  _crossfade = true;
+  return true;
+}
+
+void Segment::endCrossfade() {
+  std::swap(_pixels, _t->_xfPixels);
+  std::swap(_pixelsLen, _t->_xfLen);
+  std::swap(_pixelsWidth, _t->_xfWidth);
+  std::swap(_pixelsHeight, _t->_xfHeight);
+  _crossfade = false;
+  const uint32_t *old = _t->_xfPixels;
+  const unsigned prog = 0xFFFFU - progress();
+  if (_pixels) {
+    // both effects are in segment buffers (virtual pixels), layout only differs if old effect uses other options
+    if (_pixelsWidth != _t->_xfWidth) return;
+    const unsigned len = std::min(_pixelsLen, _t->_xfLen);
+    for (unsigned i = 0; i < len; i++) _pixels[i] = color_blend16(_pixels[i], old[i], prog);
+  } else {
+    // _modeBlend is set: pixel expansion blends with strip content (new effect) by progress()
+    _expandBuffer(old, _t->_xfWidth, _t->_xfHeight, _t->_xfLen, 255U, SEG_BLEND_NORMAL);
+  }
+}
 #endif
 
 uint8_t Segment::currentBri(bool useCct) const {
@@ -448,6 +584,18 @@ void Segment::beginDraw() {
   _vHeight = virtualHeight();
   _vLength = virtualLength();
   _segBri  = currentBri();
+  bool oldFx = false; // rendering old effect of a transition
+  bool preScale = false; // old and new effect use different brightness during transition, buffer holds scaled colors
+  #ifndef WLED_DISABLE_MODE_BLEND
+  oldFx    = _modeBlend;
+  preScale = isInTransition() && blendingStyle != BLEND_STYLE_FADE;
+  #endif
+  if (!oldFx) { // old effect may use different options (i.e. mirror) which must not resize the buffer
+    if (strip.hasPixelBuffer()) allocatePixels();
+    else                        deallocatePixels();
+    _pixelsBri = preScale ? 255U : _segBri;
+  }
+  if (_pixels && !preScale) _segBri = 255U; // brightness is applied in composite()
   unsigned prog = isInTransition() ? progress() : 0xFFFFU;  // transition progress; 0xFFFFU = no transition active
   // adjust gamma for effects
   for (unsigned i = 0; i < NUM_COLORS; i++) {
@@ -537,6 +685,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   // apply change immediately
   if (i2 <= i1) { //disable segment
     stop = 0;
+    deallocatePixels();
     return;
   }
   if (i1 < Segment::maxWidth || (i1 >= Segment::maxWidth*Segment::maxHeight && i1 < strip.getLengthTotal())) start = i1; // Segment::maxWidth equals strip.getLengthTotal() for 1D
@@ -961,11 +1110,32 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col) const
 
   if (i >= vL || i < 0 || isPixelClipped(i)) return; // handle clipping on 1D
 
-  unsigned len = length();
   // if color is unscaled
   if (!_colorScaled) col = color_fade(col, _segBri);
 
-  // expand pixel (taking into account start, grouping, spacing [and offset])
+  if (_pixels) { // segment buffer: mapping to physical pixels is done in composite()
+    if (unsigned(i) < _pixelsLen) {
+#ifndef WLED_DISABLE_MODE_BLEND
+      // _modeBlend==true -> old effect (unless drawing into its own crossfade buffer)
+      if (_modeBlend && !_crossfade && blendingStyle == BLEND_STYLE_FADE) col = color_blend16(_pixels[i], col, 0xFFFFU - progress());
+#endif
+      _pixels[i] = col;
+    }
+    return;
+  }
+  _expandPixel(i, col, SEG_BLEND_NORMAL);
+}
+
+// writes strip pixel, blending with its current content according to layer blend mode
+static inline void setStripPixel(unsigned i, uint32_t col, uint8_t bm) {
+  if (bm != SEG_BLEND_NORMAL) col = color_blend_mode(strip.getPixelColor(i), col, bm);
+  strip.setPixelColor(i, col);
+}
+
+// expand pixel (taking into account start, grouping, spacing [and offset])
+void IRAM_ATTR_YN Segment::_expandPixel(int i, uint32_t col, uint8_t bm) const
+{
+  unsigned len = length();
   i = i * groupLength();
   if (reverse) { // is segment reversed?
     if (mirror) { // is segment mirrored?
@@ -989,7 +1159,7 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col) const
         // _modeBlend==true -> old effect
         if (_modeBlend && blendingStyle == BLEND_STYLE_FADE) tmpCol = color_blend16(strip.getPixelColor(indexMir), col, 0xFFFFU - progress());
 #endif
-        strip.setPixelColor(indexMir, tmpCol);
+        setStripPixel(indexMir, tmpCol, bm);
       }
       indexSet += offset; // offset/phase
       if (indexSet >= stop) indexSet -= len; // wrap
@@ -997,7 +1167,7 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col) const
         // _modeBlend==true -> old effect
       if (_modeBlend && blendingStyle == BLEND_STYLE_FADE) tmpCol = color_blend16(strip.getPixelColor(indexSet), col, 0xFFFFU - progress());
 #endif
-      strip.setPixelColor(indexSet, tmpCol);
+      setStripPixel(indexSet, tmpCol, bm);
     }
   }
 }
@@ -1097,6 +1267,8 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColor(int i) const
 
   if (i >= vL || i < 0 || isPixelClipped(i)) return 0; // handle clipping on 1D
 
+  if (_pixels) return unsigned(i) < _pixelsLen ? _pixels[i] : 0;
+
   if (reverse) i = vL - i - 1;
   i *= groupLength();
   i += start;
@@ -1106,6 +1278,60 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColor(int i) const
   return strip.getPixelColor(i);
 }
 
+bool Segment::_isXYBuffer() const {
+#ifndef WLED_DISABLE_2D
+  return is2D() || (Segment::maxHeight != 1 && (width() == 1 || height() == 1) && start < Segment::maxWidth*Segment::maxHeight);
+#else
+  return false;
+#endif
+}
+
+// expands a buffer of virtual pixels (w x h, or len in 1D) onto physical strip pixels with brightness and blend mode
+// writes len virtual pixels as consecutive strip pixels from pix on, in chunks so the ledmap is resolved once per span
+static void expandSpan(unsigned pix, const uint32_t *buf, unsigned len, uint8_t bri) {
+  uint32_t span[64];
+  for (unsigned i = 0; i < len; i += 64) {
+    const unsigned n = std::min(len - i, 64U);
+    for (unsigned k = 0; k < n; k++) span[k] = color_fade(buf[i+k], bri);
+    strip.setPixelColors(pix + i, span, n);
+  }
+}
+
+void Segment::_expandBuffer(const uint32_t *buf, unsigned w, unsigned h, unsigned len, uint8_t bri, uint8_t bm) const {
+  // virtual pixels are physical ones (no grouping, spacing, reverse, mirror or transpose) that are simply overwritten
+  bool spans = bm == SEG_BLEND_NORMAL && groupLength() == 1 && !reverse && !mirror && !reverse_y && !mirror_y && !transpose;
+#ifndef WLED_DISABLE_MODE_BLEND
+  if (_modeBlend && blendingStyle == BLEND_STYLE_FADE) spans = false;
+#endif
+#ifndef WLED_DISABLE_2D
+  if (_isXYBuffer()) {
+    // geometry may have changed since buffer was drawn (frozen segment), only use the overlapping part
+    const int vW = std::min(virtualWidth(), w);
+    const int vH = std::min(virtualHeight(), h);
+    for (int y = 0; y < vH; y++) {
+      const uint32_t *row = buf + y * w;
+      if (spans) expandSpan((startY + y) * Segment::maxWidth + start, row, vW, bri);
+      else for (int x = 0; x < vW; x++) _expandPixelXY(x, y, color_fade(row[x], bri), vW, vH, bm);
+    }
+    return;
+  }
+#endif
+  const int vL = std::min((unsigned)virtualLength(), len);
+  if (spans && offset == 0) expandSpan(start, buf, vL, bri);
+  else for (int i = 0; i < vL; i++) _expandPixel(i, color_fade(buf[i], bri), bm);
+}
+
+/*
+ * Writes segment buffer into strip buffer: applies segment brightness, expands virtual pixels to physical ones
+ * (grouping, spacing, offset, reverse, mirror, transpose, 1D->2D) and blends with underlying segments.
+ * Called once per frame for each active segment in segment order (later segments are on top).
+ * Layer blend modes are only applied if the strip buffer was cleared for this frame (useBlendModes), else the segment is copied.
+ */
+void Segment::composite(bool useBlendModes) const {
+  if (!_pixels || !isActive()) return;
+  _expandBuffer(_pixels, _pixelsWidth, _pixelsHeight, _pixelsLen, _pixelsBri, useBlendModes && blendMode < SEG_BLEND_COUNT ? blendMode : SEG_BLEND_NORMAL);
+}
+
 uint8_t Segment::differs(const Segment& b) const {
   uint8_t d = 0;
   if (start != b.start)         d |= SEG_DIFFERS_BOUNDS;
@@ -1114,6 +1340,7 @@ uint8_t Segment::differs(const Segment& b) const {
   if (grouping != b.grouping)   d |= SEG_DIFFERS_GSO;
   if (spacing != b.spacing)     d |= SEG_DIFFERS_GSO;
   if (opacity != b.opacity)     d |= SEG_DIFFERS_BRI;
+  if (blendMode != b.blendMode) d |= SEG_DIFFERS_OPT;
   if (mode != b.mode)           d |= SEG_DIFFERS_FX;
   if (speed != b.speed)         d |= SEG_DIFFERS_FX;
   if (intensity != b.intensity) d |= SEG_DIFFERS_FX;
@@ -1190,7 +1417,7 @@ void Segment::clear() {
     _vWidth  = virtualWidth();
     _vHeight = virtualHeight();
     _vLength = virtualLength();
-    _segBri  = currentBri();
+    _segBri  = _pixels ? 255U : currentBri();
     fill(BLACK);
     _vWidth  = oldVW;
     _vHeight = oldVH;
@@ -1198,6 +1425,24 @@ void Segment::clear() {
     _segBri  = oldSB;
 }
 
+/*
+ * Whole-segment operations (fill, fades, blur) work on rows of the segment buffer directly
+ * instead of a get/setPixelColor() round trip per pixel if virtual pixel (x,y) is
+ * _pixels[y*stride + x], i.e. no transition style moves or clips pixels and the old effect
+ * of a fade is not blended on write. Brightness is then applied in composite() (_segBri is 255).
+ * Returns nullptr if the operation has to go through set/getPixelColor().
+ */
+uint32_t *Segment::_spanPixels(unsigned cols, unsigned rows, unsigned &stride) const {
+  if (!_pixels || cols == 0 || rows == 0) return nullptr;
+#ifndef WLED_DISABLE_MODE_BLEND
+  if (isInTransition() && (blendingStyle != BLEND_STYLE_FADE || (_modeBlend && !_crossfade))) return nullptr;
+#endif
+  if (rows > 1 && !is2D()) return nullptr; // 1D segment on a matrix: the per-pixel loops revisit the strip for every row
+  stride = rows > 1 ? _pixelsWidth : cols;
+  if (cols > stride || (rows - 1) * stride + cols > _pixelsLen) return nullptr;
+  return _pixels;
+}
+
 /*
  * Fills segment with color
  */
@@ -1207,6 +1452,11 @@ void Segment::fill(uint32_t c) {
   const int rows = vHeight(); // will be 1 for 1D
   // pre-scale color for all pixels
   c = color_fade(c, _segBri);
+  unsigned stride;
+  if (uint32_t *px = _spanPixels(cols, rows, stride)) {
+    for (int y = 0; y < rows; y++) std::fill_n(px + y * stride, cols, c);
+    return;
+  }
   _colorScaled = true;
   for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
     if (is2D()) setPixelColorXY(x, y, c);
@@ -1215,6 +1465,22 @@ void Segment::fill(uint32_t c) {
   _colorScaled = false;
 }
 
+// one step of fade_out(): move each channel of color toward target by mappedRate/256 of the difference, at least by 1
+static inline uint32_t fadeOutColor(uint32_t color, uint32_t target, int mappedRate) {
+  for (int i = 0; i < 32; i += 8) {
+    uint8_t c2 = (target>>i);     // get background channel
+    uint8_t c1 = (color>>i);      // get foreground channel
+    // we can't use bitshift since we are using int
+    int delta = (c2 - c1) * mappedRate / 256;
+    // if fade isn't complete, make sure delta is at least 1 (fixes rounding issues)
+    if (delta == 0) delta += (c2 == c1) ? 0 : (c2 > c1) ? 1 : -1;
+    // stuff new value back into color
+    color &= ~(0xFF<<i);
+    color |= ((c1 + delta) & 0xFF) << i;
+  }
+  return color;
+}
+
 /*
  * fade out function, higher rate = quicker fade
  * fading is highly dependant on frame rate (higher frame rates, faster fading)
@@ -1227,21 +1493,20 @@ void Segment::fade_out(uint8_t rate) {
 
   rate = (256-rate) >> 1;
   const int mappedRate = 256 / (rate + 1);
+  const uint32_t target = colors[1];
 
+  unsigned stride;
+  if (uint32_t *px = _spanPixels(cols, rows, stride)) {
+    for (int y = 0; y < rows; y++) {
+      uint32_t *row = px + y * stride;
+      for (int x = 0; x < cols; x++) if (row[x] != target) row[x] = fadeOutColor(row[x], target, mappedRate);
+    }
+    return;
+  }
   for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
     uint32_t color = is2D() ? getPixelColorXY(x, y) : getPixelColor(x);
-    if (color == colors[1]) continue; // already at target color
-    for (int i = 0; i < 32; i += 8) {
-      uint8_t c2 = (colors[1]>>i);  // get background channel
-      uint8_t c1 = (color>>i);      // get foreground channel
-      // we can't use bitshift since we are using int
-      int delta = (c2 - c1) * mappedRate / 256;
-      // if fade isn't complete, make sure delta is at least 1 (fixes rounding issues)
-      if (delta == 0) delta += (c2 == c1) ? 0 : (c2 > c1) ? 1 : -1;
-      // stuff new value back into color
-      color &= ~(0xFF<<i);
-      color |= ((c1 + delta) & 0xFF) << i;
-    }
+    if (color == target) continue; // already at target color
+    color = fadeOutColor(color, target, mappedRate);
     if (is2D()) setPixelColorXY(x, y, color);
     else        setPixelColor(x, color);
   }
@@ -1253,6 +1518,11 @@ void Segment::fadeToSecondaryBy(uint8_t fadeBy) {
   const int cols = is2D() ? vWidth() : vLength();
   const int rows = vHeight(); // will be 1 for 1D
 
+  unsigned stride;
+  if (uint32_t *px = _spanPixels(cols, rows, stride)) {
+    for (int y = 0; y < rows; y++) color_blend_span(px + y * stride, cols, 1, colors[1], fadeBy);
+    return;
+  }
   for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
     if (is2D()) setPixelColorXY(x, y, color_blend(getPixelColorXY(x,y), colors[1], fadeBy));
     else        setPixelColor(x, color_blend(getPixelColor(x), colors[1], fadeBy));
@@ -1265,6 +1535,11 @@ void Segment::fadeToBlackBy(uint8_t fadeBy) {
   const int cols = is2D() ? vWidth() : vLength();
   const int rows = vHeight(); // will be 1 for 1D
 
+  unsigned stride;
+  if (uint32_t *px = _spanPixels(cols, rows, stride)) {
+    for (int y = 0; y < rows; y++) color_fade_span(px + y * stride, cols, 1, 255-fadeBy);
+    return;
+  }
   for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
     if (is2D()) setPixelColorXY(x, y, color_fade(getPixelColorXY(x,y), 255-fadeBy));
     else        setPixelColor(x, color_fade(getPixelColor(x), 255-fadeBy));
@@ -1288,6 +1563,11 @@ void Segment::blur(uint8_t blur_amount, bool smear) {
   uint8_t keep = smear ? 255 : 255 - blur_amount;
   uint8_t seep = blur_amount >> 1;
   unsigned vlength = vLength();
+  unsigned stride;
+  if (uint32_t *px = _spanPixels(vlength, 1, stride)) {
+    color_blur_span(px, vlength, 1, keep, seep);
+    return;
+  }
   uint32_t carryover = BLACK;
   uint32_t lastnew;       // not necessary to initialize lastnew and last, as both will be initialized by the first loop iteration
   uint32_t last;
@@ -1363,6 +1643,46 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Frame time statistics
+///////////////////////////////////////////////////////////////////////////////
+
+void FrameTime::reset() {
+  last = avg = 0;
+  minPrev = minCur = UINT32_MAX;
+  maxPrev = maxCur = 0;
+  samples = 0;
+}
+
+void FrameTime::add(uint32_t us) {
+  last = us;
+  if (avg == 0) avg = us << FRAME_STAT_AVG; // seed moving average with first sample
+  else          avg = avg - (avg >> FRAME_STAT_AVG) + us;
+  if (us < minCur) minCur = us;
+  if (us > maxCur) maxCur = us;
+  if (++samples >= FRAME_STAT_WINDOW) {
+    // roll window: keep previous so that min/max never describe just a handful of samples
+    minPrev = minCur; maxPrev = maxCur;
+    minCur  = UINT32_MAX; maxCur = 0;
+    samples = 0;
+  }
+}
+
+void FrameStat::reset() {
+  FrameTime::reset();
+  count = 0;
+  memset(hist, 0, sizeof(hist));
+}
+
+void FrameStat::add(uint32_t us) {
+  FrameTime::add(us);
+  count++;
+  unsigned b = us >> 8; // 256us granularity
+  b = b ? 32 - __builtin_clz(b) : 0;
+  hist[b < FRAME_STAT_BUCKETS ? b : FRAME_STAT_BUCKETS-1]++;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // WS2812FX class implementation
 ///////////////////////////////////////////////////////////////////////////////
@@ -1514,6 +1834,10 @@ void WS2812FX::finalizeInit() {
   Segment::maxWidth  = _length;
   Segment::maxHeight = 1;
 
+  // strip buffer is re-allocated for new length in service()
+  if (_pixels) free(_pixels);
+  _pixels = nullptr;
+
   //segments are created in makeAutoSegments();
   DEBUG_PRINTLN(F("Loading custom palettes"));
   loadCustomPalettes(); // (re)load all custom palettes
@@ -1523,19 +1847,40 @@ void WS2812FX::finalizeInit() {
 
 void WS2812FX::service() {
   unsigned long nowUp = millis(); // Be aware, millis() rolls over every 49 days
-  now = nowUp + timebase;
+  now = nowUp + clockOffset + timebase;
   if (_suspend) return;
   unsigned long elapsed = nowUp - _lastServiceShow;
 
   if (elapsed <= MIN_FRAME_DELAY) return;                                        // keep wifi alive - no matter if triggered or unlimited
   if ( !_triggered && (_targetFps != FPS_UNLIMITED)) {                           // unlimited mode = no frametime
-    if (elapsed < _frametime) return;                                            // too early for service
+    if (clockLocked) {
+      // frame locked to the network clock: render once per frame slot and give the effects the slot start
+      // as time, so nodes with synchronised clocks compute the same frame at the same moment
+      unsigned long slot = (nowUp + clockOffset) / _frametime;
+      if (slot == _lastFrameSlot) return;                                        // too early for service
+      _lastFrameSlot = slot;
+      now   = slot * _frametime + timebase;
+      nowUp = slot * _frametime - clockOffset;                                   // local time of the slot start, keeps segment timing on the grid
+    } else if (elapsed < _frametime) return;                                     // too early for service
+  }
+
+  // strip buffer for segment compositing; (re)allocated here as it may be released in finalizeInit()
+  if (useSegmentBuffers && !_pixels) {
+    _pixels = static_cast<uint32_t*>(calloc(_length, sizeof(uint32_t)));
+    if (!_pixels) DEBUG_PRINTLN(F("!!! Strip buffer allocation failed. !!!"));
+  } else if (!useSegmentBuffers && _pixels) {
+    free(_pixels);
+    _pixels = nullptr;
   }
 
   bool doShow = false;
+  unsigned long serviceStart = micros();
+  unsigned fxTime = 0, blendTime = 0, xfadeTime = 0;
+  bool blended = false, crossfaded = false;
 
   _isServicing = true;
   _segment_index = 0;
+  if (_segmentStats.size() != _segments.size()) _segmentStats.resize(_segments.size());
 
   for (segment &seg : _segments) {
     if (_suspend) break; // immediately stop processing segments if suspend requested during service()
@@ -1562,10 +1907,15 @@ void WS2812FX::service() {
         // Effect blending
         // When two effects are being blended, each may have different segment data, this
         // data needs to be saved first and then restored before running previous mode.
-        // The blending will largely depend on the effect behaviour since actual output (LEDs) may be
-        // overwritten by later effect. To enable seamless blending for every effect, additional LED buffer
-        // would need to be allocated for each effect and then blended together for each pixel.
+        // For fade transitions the old effect draws into a crossfade buffer (if it fits into the pool) which is
+        // then blended with new effect's output pixel by pixel. Other styles use clipping instead, and if there
+        // is no crossfade buffer old effect draws over new effect blending each pixel it sets.
         seg.beginDraw();                      // set up parameters for get/setPixelColor()
+        unsigned long fxStart = micros();
+        unsigned fxBlend = 0;                 // time spent rendering old effect during transition
+        unsigned fxXfade = 0;                 // time spent capturing/blending crossfade buffer
+        bool     inBlend = false;
+        bool     inXfade = false;
 #ifndef WLED_DISABLE_MODE_BLEND
         Segment::setClippingRect(0, 0); // disable clipping (just in case)
         if (seg.isInTransition()) {
@@ -1641,23 +1991,52 @@ void WS2812FX::service() {
               Segment::setClippingRect(0, dw, h - dh, h);
               break;
           }
+          Segment::tmpsegd_t _tmpSegData;
+          if (blendingStyle == BLEND_STYLE_FADE && !seg.hasCrossfade()) {
+            // first frame of fade: capture old effect's output before new effect draws over it
+            unsigned long xfStart = micros();
+            Segment::modeBlend(true);         // set semaphore
+            seg.swapSegenv(_tmpSegData);      // old effect options determine buffer layout
+            seg.beginDraw();
+            inXfade = seg.allocateCrossfade();
+            seg.restoreSegenv(_tmpSegData);
+            Segment::modeBlend(false);        // unset semaphore
+            seg.beginDraw();
+            fxXfade = micros() - xfStart;
+          }
           frameDelay = (*_mode[m])();         // run new/current mode
+          unsigned long blendStart = micros();
           // now run old/previous mode
-          Segment::tmpsegd_t _tmpSegData;
           Segment::modeBlend(true);           // set semaphore
           seg.swapSegenv(_tmpSegData);        // temporarily store new mode state (and swap it with transitional state)
           seg.beginDraw();                    // set up parameters for get/setPixelColor()
+          bool xfade = seg.beginCrossfade();  // draw into crossfade buffer
           frameDelay = min(frameDelay, (unsigned)(*_mode[seg.currentMode()])());  // run old mode
           seg.call++;                         // increment old mode run counter
+          unsigned long xfStart = micros();
+          if (xfade) seg.endCrossfade();      // blend old effect over new effect
+          unsigned xfBlend = micros() - xfStart;
           seg.restoreSegenv(_tmpSegData);     // restore mode state (will also update transitional state)
           Segment::modeBlend(false);          // unset semaphore
           blendingStyle = orgBS;              // restore blending style if it was modified for single pixel segment
+          if (xfade) { fxXfade += xfBlend; inXfade = true; }
+          else       xfBlend = 0;
+          fxBlend = micros() - blendStart - xfBlend;
+          inBlend = true;
         } else
 #endif
         frameDelay = (*_mode[seg.mode])();         // run effect mode (not in transition)
         seg.call++;
         if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
         BusManager::setSegmentCCT(oldCCT); // restore old CCT for ABL adjustments
+
+        unsigned fxSeg = micros() - fxStart - fxBlend - fxXfade;
+        segment_time_t &segStat = _segmentStats[_segment_index];
+        if (segStat.mode != seg.mode) { segStat.fx.reset(); segStat.blend.reset(); segStat.mode = seg.mode; }
+        segStat.fx.add(fxSeg);
+        fxTime += fxSeg;
+        if (inBlend) { segStat.blend.add(fxBlend); blendTime += fxBlend; blended = true; }
+        if (inXfade) { xfadeTime += fxXfade; crossfaded = true; }
       }
 
       seg.next_time = nowUp + frameDelay;
@@ -1665,6 +2044,16 @@ void WS2812FX::service() {
     _segment_index++;
   }
   Segment::setClippingRect(0, 0);             // disable clipping for overlays
+  if (doShow && _pixels && !_suspend) {
+    // composite segment buffers into strip buffer (segments without buffer have drawn into it already)
+    unsigned long compStart = micros();
+    bool allBuffered = true;
+    for (const segment &seg : _segments) if (seg.isActive() && !seg.hasPixelBuffer()) allBuffered = false;
+    if (allBuffered) memset(_pixels, 0, _length * sizeof(uint32_t)); // blend modes need a black background
+    // otherwise the background holds the last composite where unbuffered segments did not redraw, blending onto it would accumulate
+    for (const segment &seg : _segments) seg.composite(allBuffered);
+    _frameStats.comp.add(micros() - compStart);
+  }
   _isServicing = false;
   _triggered = false;
 
@@ -1672,10 +2061,14 @@ void WS2812FX::service() {
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
   #endif
   if (doShow) {
+    _frameStats.fx.add(fxTime);
+    if (blended) _frameStats.blend.add(blendTime);
+    if (crossfaded) _frameStats.xfade.add(xfadeTime);
     yield();
     Segment::handleRandomPalette(); // slowly transition random palette; move it into for loop when each segment has individual random palette
     _lastServiceShow = nowUp; // update timestamp, for precise FPS control
     if (!_suspend) show();
+    _frameStats.frame.add(micros() - serviceStart);
   }
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow strip %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
@@ -1685,25 +2078,135 @@ void WS2812FX::service() {
 void IRAM_ATTR WS2812FX::setPixelColor(unsigned i, uint32_t col) const {
   i = getMappedPixelIndex(i);
   if (i >= _length) return;
-  BusManager::setPixelColor(i, col);
+  if (_pixels) _pixels[i] = col; // written to busses in show()
+  else         BusManager::setPixelColor(i, col);
+}
+
+// finds the mapping run containing logical pixel index (< customMappingSize) if it is not the one of the last lookup
+unsigned IRAM_ATTR WS2812FX::searchMappingRun(unsigned index) const {
+  const mapping_run_t *runs = customMappingRuns; // runs[customMappingRunCount].first is customMappingSize
+  unsigned r = _mappingCursor + 1;
+  if (index < runs[r].first || index >= runs[r+1].first) { // not the next run either: binary search
+    const mapping_run_t *run = runs;
+    for (unsigned n = customMappingRunCount; n > 1; ) {
+      unsigned half = n / 2;
+      if (run[half].first <= index) run += half; // (branchless)
+      n -= half;
+    }
+    r = run - runs;
+  }
+  _mappingCursor = r;
+  return r;
+}
+
+void WS2812FX::clearMapping() {
+  customMappingSize = 0;
+  if (customMappingTable) free(customMappingTable);
+  if (customMappingRuns) free(customMappingRuns);
+  customMappingTable = nullptr;
+  customMappingRuns = nullptr;
+  customMappingRunCount = 0;
+  _mappingCursor = 0;
+}
+
+// number of consecutive table entries from i on that have a constant step
+static unsigned mappingRunLength(const uint16_t *table, unsigned i, unsigned len) {
+  unsigned run = 1;
+  if (i + 1 < len) {
+    uint16_t step = table[i+1] - table[i];
+    while (i + run < len && (uint16_t)(table[i+run] - table[i+run-1]) == step) run++;
+  }
+  return run;
+}
+
+// serpentine, panel and gap maps are a few runs per row: keeping those instead of the table saves most of its RAM
+// and lets spans be mapped once per run; irregular maps keep the table (lookups in it are cheaper)
+void WS2812FX::compactMapping() {
+  if (!customMappingTable || !customMappingSize) return;
+  const unsigned limit = customMappingSize * sizeof(uint16_t) / (4 * sizeof(mapping_run_t)); // runs may take a quarter of the table
+  unsigned count = 0;
+  for (unsigned i = 0; i < customMappingSize; i += mappingRunLength(customMappingTable, i, customMappingSize)) {
+    if (++count > limit) return;
+  }
+  mapping_run_t *runs = static_cast<mapping_run_t*>(malloc((count + 1) * sizeof(mapping_run_t)));
+  if (!runs) return;
+  count = 0;
+  for (unsigned i = 0; i < customMappingSize; ) {
+    unsigned run = mappingRunLength(customMappingTable, i, customMappingSize);
+    runs[count++] = {uint16_t(i), customMappingTable[i], int16_t(run > 1 ? customMappingTable[i+1] - customMappingTable[i] : 0)};
+    i += run;
+  }
+  runs[count] = {customMappingSize, 0xFFFFU, 0}; // end marker, saves bounds checks in lookups
+  DEBUG_PRINTF_P(PSTR("Ledmap compacted: %u runs, %uB instead of %uB\n"), count, (count + 1) * sizeof(mapping_run_t), customMappingSize * sizeof(uint16_t));
+  free(customMappingTable);
+  customMappingTable = nullptr;
+  customMappingRuns = runs;
+  customMappingRunCount = count;
+  _mappingCursor = 0;
+}
+
+// same as setPixelColor() for consecutive pixels; without a ledmap the run is handed to the busses in one go,
+// a ledmap made of runs is resolved once per run
+void WS2812FX::setPixelColors(unsigned i, const uint32_t *c, unsigned len) const {
+  if (customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) {
+    if (customMappingTable) {
+      for (unsigned n = 0; n < len; n++) setPixelColor(i + n, c[n]);
+      return;
+    }
+    while (len && i < customMappingSize) {
+      unsigned r = findMappingRun(i);
+      const mapping_run_t &run = customMappingRuns[r];
+      unsigned n = std::min(len, customMappingRuns[r+1].first - i);
+      uint16_t pix = run.start + (i - run.first) * run.step;
+      if (run.step == 1 && pix < _length) {
+        unsigned m = std::min(n, unsigned(_length - pix));
+        if (_pixels) memcpy(_pixels + pix, c, m * sizeof(uint32_t));
+        else         BusManager::setPixelColors(pix, c, m);
+      } else if (run.step != 0 || pix < _length) {
+        for (unsigned k = 0; k < n; k++, pix += run.step) {
+          if (pix >= _length) continue;
+          if (_pixels) _pixels[pix] = c[k];
+          else         BusManager::setPixelColor(pix, c[k]);
+        }
+      }
+      i += n; c += n; len -= n;
+    }
+    if (!len) return; // pixels past the ledmap are not mapped
+  }
+  if (i >= _length) return;
+  if (len > _length - i) len = _length - i;
+  if (_pixels) memcpy(_pixels + i, c, len * sizeof(uint32_t)); // written to busses in show()
+  else         BusManager::setPixelColors(i, c, len);
 }
 
 uint32_t IRAM_ATTR WS2812FX::getPixelColor(unsigned i) const {
   i = getMappedPixelIndex(i);
   if (i >= _length) return 0;
-  return BusManager::getPixelColor(i);
+  return _pixels ? _pixels[i] : BusManager::getPixelColor(i);
 }
 
 void WS2812FX::show() {
   // avoid race condition, capture _callback value
   show_callback callback = _callback;
-  if (callback) callback();
+  unsigned long showStart = micros();
+  if (callback) {
+    callback();
+    _frameStats.overlay.add(micros() - showStart);
+  }
   unsigned long showNow = millis();
 
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
+  unsigned long busStart = micros();
+  if (_pixels) BusManager::setPixelColors(0, _pixels, _length); // each bus pixel is written once per frame
   BusManager::show();
+  unsigned long showEnd = micros();
+  _frameStats.bus.add(showEnd - busStart);
+  _frameStats.show.add(showEnd - showStart);
+  #ifdef WLED_ENABLE_RT_LATENCY
+  realtimeLatencyShown(showStart, showEnd);
+  #endif
 
   size_t diff = showNow - _lastShow;
 
@@ -1992,7 +2495,8 @@ void WS2812FX::printSize() {
   for (const Segment &seg : _segments) DEBUG_PRINTF_P(PSTR("  Seg: %d,%d [A=%d, 2D=%d, RGB=%d, W=%d, CCT=%d]\n"), seg.width(), seg.height(), seg.isActive(), seg.is2D(), seg.hasRGB(), seg.hasWhite(), seg.isCCT());
   DEBUG_PRINTF_P(PSTR("Modes: %d*%d=%uB\n"), sizeof(mode_ptr), _mode.size(), (_mode.capacity()*sizeof(mode_ptr)));
   DEBUG_PRINTF_P(PSTR("Data: %d*%d=%uB\n"), sizeof(const char *), _modeData.size(), (_modeData.capacity()*sizeof(const char *)));
-  DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
+  if (customMappingRuns) DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB (%d pixels)\n"), sizeof(mapping_run_t), (int)customMappingRunCount+1, (customMappingRunCount+1)*sizeof(mapping_run_t), (int)customMappingSize);
+  else                   DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
 }
 #endif
 
@@ -2045,97 +2549,335 @@ void WS2812FX::loadCustomPalettes() {
   }
 }
 
-//load custom mapping table from JSON file (called from finalizeInit() or deserializeState())
+/*
+ * Binary ledmaps
+ * ledmap.lmb / ledmapN.lmb hold the same map as ledmap.json / ledmapN.json in a compact form that is
+ * decoded while streaming the file in blocks (tools/ledmap_convert.py converts between the two).
+ * If both exist the binary one is used. Little endian:
+ *   "WLM" 1                       magic, format version
+ *   uint16 width, uint16 height   matrix size (as "width"/"height" in JSON), 0 if not given
+ *   uint16 count                  number of map entries
+ *   uint8  nameLen, name          (as "n" in JSON)
+ *   runs until count entries are produced, each starting with uint16 h:
+ *     h & 0x8000  (h & 0x7FFF) entries start, start+step, start+2*step, ... followed by uint16 start, int16 step
+ *     else        h entries follow as uint16 each
+ *   0xFFFF is an unused position (-1 in JSON)
+ * Loaded maps (binary or JSON) are kept encoded in a small cache, so switching between a few ledmaps,
+ * as presets do, needs neither the file system nor the JSON buffer. A cached map only holds as many
+ * entries as the strip had LEDs when it was loaded, it is read from the file again if that changed.
+ */
+#define LEDMAP_BLOCK       512  // file read size
+
+typedef struct LedmapCacheEntry {
+  uint8_t *data;     // encoded map (without the name), nullptr if free
+  size_t   size;
+  uint16_t length;   // getLengthTotal() the map was loaded for
+  uint8_t  n;
+  uint32_t lastUsed;
+} ledmap_cache_entry_t;
+
+static ledmap_cache_entry_t ledmapCache[WLED_LEDMAP_CACHE_ENTRIES];
+static size_t   ledmapCacheBytes = 0;
+static uint32_t ledmapCacheUse = 0;
+static volatile bool ledmapCacheStale = false; // set by invalidateLedmapCache(), entries are freed at the next lookup
+
+// source of encoded map data: a memory buffer or a file read in blocks
+class LedmapReader {
+  public:
+    LedmapReader(const uint8_t *data, size_t size) : _data(data), _len(size) {}
+    LedmapReader(File *file) : _file(file), _data(_buf) {}
+
+    bool read(uint8_t *dst, size_t n) {
+      while (n) {
+        if (_pos >= _len) {
+          if (!_file || !(_len = _file->read(_buf, sizeof(_buf)))) return false;
+          _pos = 0;
+        }
+        size_t c = min(n, _len - _pos);
+        memcpy(dst, _data + _pos, c);
+        _pos += c;
+        dst += c;
+        n -= c;
+      }
+      return true;
+    }
+    bool readU16(uint16_t &v) {
+      uint8_t b[2];
+      if (!read(b, 2)) return false;
+      v = b[0] | (b[1] << 8);
+      return true;
+    }
+
+  private:
+    File          *_file = nullptr;
+    const uint8_t *_data;
+    size_t         _pos = 0, _len = 0;
+    uint8_t        _buf[LEDMAP_BLOCK];
+};
+
+static bool readLedmapHeader(LedmapReader &in, uint16_t &width, uint16_t &height, uint16_t &count, char *name, size_t nameSize) {
+  uint8_t magic[4], nameLen;
+  if (!in.read(magic, 4) || memcmp_P(magic, PSTR("WLM\x01"), 4)) return false;
+  if (!in.readU16(width) || !in.readU16(height) || !in.readU16(count) || !in.read(&nameLen, 1)) return false;
+  uint8_t c;
+  for (unsigned i = 0; i < nameLen; i++) {
+    if (!in.read(&c, 1)) return false;
+    if (name && i < nameSize - 1) name[i] = c;
+  }
+  if (name && nameSize) name[min((size_t)nameLen, nameSize - 1)] = 0;
+  return true;
+}
+
+// decodes up to len of count map entries into table, returns the number of entries decoded
+static unsigned decodeLedmap(LedmapReader &in, unsigned count, uint16_t *table, unsigned len) {
+  unsigned i = 0;
+  uint16_t h, v;
+  while (i < count && i < len && in.readU16(h)) {
+    unsigned run = h & 0x7FFF;
+    if (h & 0x8000) {
+      uint16_t step;
+      if (!in.readU16(v) || !in.readU16(step)) break;
+      for (unsigned k = 0; k < run && i < len; k++, v += step) table[i++] = v;
+    } else {
+      for (unsigned k = 0; k < run && i < len; k++) {
+        if (!in.readU16(v)) return i;
+        table[i++] = v;
+      }
+    }
+  }
+  return i;
+}
+
+// encodes count entries of table (header without name, then runs); returns the size, writes nothing if out is nullptr
+static size_t encodeLedmap(const uint16_t *table, unsigned count, uint16_t width, uint16_t height, uint8_t *out) {
+  size_t size = 0;
+  auto put16 = [&](uint16_t v) { if (out) { out[size] = v & 0xFF; out[size+1] = v >> 8; } size += 2; };
+  if (out) memcpy_P(out, PSTR("WLM\x01"), 4);
+  size = 4;
+  put16(width); put16(height); put16(count);
+  if (out) out[size] = 0; // no name
+  size++;
+
+  unsigned i = 0, lit = 0; // literal entries pending before i
+  auto flushLiterals = [&]() {
+    while (lit) {
+      unsigned run = min(lit, 0x7FFFU);
+      put16(run);
+      for (unsigned k = i - lit; k < i - lit + run; k++) put16(table[k]);
+      lit -= run;
+    }
+  };
+  while (i < count) {
+    unsigned run = 1;
+    uint16_t step = (i + 1 < count) ? table[i+1] - table[i] : 0;
+    while (i + run < count && run < 0x7FFF && (uint16_t)(table[i+run] - table[i+run-1]) == step) run++;
+    if (run >= 4) { // a step run takes 6 bytes, as much as 3 literal entries
+      flushLiterals();
+      put16(0x8000 | run); put16(table[i]); put16(step);
+      i += run;
+    } else {
+      i++;
+      lit++;
+    }
+  }
+  flushLiterals();
+  return size;
+}
+
+// may be called from the async web server task while deserializeMap() uses an entry: only flag the cache
+void WS2812FX::invalidateLedmapCache() {
+  ledmapCacheStale = true;
+}
+
+static void dropCachedLedmap(ledmap_cache_entry_t &e) {
+  free(e.data);
+  ledmapCacheBytes -= e.size;
+  e = {};
+}
+
+// returns the cached map n if it was loaded for a strip of len LEDs (else it is dropped)
+static ledmap_cache_entry_t *findCachedLedmap(unsigned n, unsigned len) {
+  if (ledmapCacheStale) {
+    ledmapCacheStale = false;
+    for (auto &e : ledmapCache) if (e.data) dropCachedLedmap(e);
+  }
+  for (auto &e : ledmapCache) {
+    if (!e.data || e.n != n) continue;
+    if (e.length == len) return &e;
+    dropCachedLedmap(e);
+  }
+  return nullptr;
+}
+
+// keeps an encoded map, evicting the least recently used ones to make room
+static void cacheLedmap(unsigned n, unsigned len, uint8_t *data, size_t size) {
+  if (size > WLED_LEDMAP_CACHE_BYTES) { free(data); return; }
+  ledmap_cache_entry_t *slot;
+  for (;;) {
+    ledmap_cache_entry_t *lru = nullptr;
+    slot = nullptr;
+    for (auto &e : ledmapCache) {
+      if (!e.data) { if (!slot) slot = &e; }
+      else if (!lru || e.lastUsed < lru->lastUsed) lru = &e;
+    }
+    if (slot && ledmapCacheBytes + size <= WLED_LEDMAP_CACHE_BYTES) break;
+    dropCachedLedmap(*lru);
+  }
+  *slot = {data, size, (uint16_t)len, (uint8_t)n, ++ledmapCacheUse};
+  ledmapCacheBytes += size;
+}
+
+static void getLedmapFileName(char *fileName, unsigned n, bool binary) {
+  strcpy_P(fileName, PSTR("/ledmap"));
+  if (n) sprintf(fileName +7, "%d", n);
+  strcat_P(fileName, binary ? PSTR(".lmb") : PSTR(".json"));
+}
+
+bool WS2812FX::getBinaryLedmapName(unsigned n, char *name, size_t len) {
+  char fileName[32];
+  getLedmapFileName(fileName, n, true);
+  File f = WLED_FS.open(fileName, "r");
+  if (!f) return false;
+  LedmapReader in(&f);
+  uint16_t width, height, count;
+  bool valid = readLedmapHeader(in, width, height, count, name, len);
+  f.close();
+  return valid;
+}
+
+// reads the numbers of the "map" array in blocks (numbers may span blocks), returns the number of entries read
+static unsigned readJsonLedmap(File &f, uint16_t *table, unsigned len) {
+  if (!f.find("\"map\"")) return 0;
+  uint8_t buf[LEDMAP_BLOCK];
+  unsigned count = 0;
+  int value = 0;
+  bool inArray = false, inNumber = false, negative = false;
+  size_t bufsize;
+  while ((bufsize = f.read(buf, sizeof(buf)))) {
+    for (size_t i = 0; i < bufsize; i++) {
+      char c = buf[i];
+      if (!inArray) { // skip ':' and whitespace up to the array
+        if (c == '[') inArray = true;
+        else if (c != ':' && c != ' ' && c != '\t' && c != '\r' && c != '\n') return 0;
+        continue;
+      }
+      if (c >= '0' && c <= '9') {
+        value = inNumber ? value * 10 + c - '0' : c - '0';
+        if (value > 65535) value = 65535;
+        inNumber = true;
+        continue;
+      }
+      if (c == '-' && !inNumber) { negative = true; continue; }
+      if (inNumber) {
+        if (count >= len) return count;
+        table[count++] = (negative || value > 16384) ? 0xFFFF : value;
+        inNumber = negative = false;
+      }
+      if (c == ']') return count;
+    }
+  }
+  return count;
+}
+
+//load custom mapping table from binary or JSON file (called from finalizeInit() or deserializeState())
 bool WS2812FX::deserializeMap(unsigned n) {
   // 2D support creates its own ledmap (on the fly) if a ledmap.json exists it will overwrite built one.
 
   char fileName[32];
-  strcpy_P(fileName, PSTR("/ledmap"));
-  if (n) sprintf(fileName +7, "%d", n);
-  strcat_P(fileName, PSTR(".json"));
-  bool isFile = WLED_FS.exists(fileName);
+  getLedmapFileName(fileName, n, true);
+  bool isBinary = WLED_FS.exists(fileName);
+  if (!isBinary) getLedmapFileName(fileName, n, false);
+  bool isFile = isBinary || WLED_FS.exists(fileName);
 
-  customMappingSize = 0; // prevent use of mapping if anything goes wrong
-  currentLedmap = 0;
   if (n == 0 || isFile) interfaceUpdateCallMode = CALL_MODE_WS_SEND; // schedule WS update (to inform UI)
 
-  if (!isFile && n==0 && isMatrix) {
-    setUpMatrix();
+  if (!isFile) {
+    customMappingSize = 0;
+    currentLedmap = 0;
+    if (n == 0 && isMatrix) setUpMatrix();
     return false;
   }
 
-  if (!isFile || !requestJSONBufferLock(7)) return false;
-
-  StaticJsonDocument<64> filter;
-  filter[F("width")]  = true;
-  filter[F("height")] = true;
-  if (!readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
-    DEBUG_PRINT(F("ERROR Invalid ledmap in ")); DEBUG_PRINTLN(fileName);
-    releaseJSONBufferLock();
-    return false; // if file does not load properly then exit
+  // the new table is filled while effects keep running on the old one, which is then swapped out
+  const unsigned len = getLengthTotal();
+  uint16_t *table = static_cast<uint16_t*>(malloc(sizeof(uint16_t)*len));
+  if (!table && (customMappingTable || customMappingRuns)) { // not enough memory for both
+    suspend();
+    clearMapping();
+    resume();
+    table = static_cast<uint16_t*>(malloc(sizeof(uint16_t)*len));
   }
-
-  suspend();
-
-  JsonObject root = pDoc->as<JsonObject>();
-  // if we are loading default ledmap (at boot) set matrix width and height from the ledmap (compatible with WLED MM ledmaps)
-  if (isMatrix && n == 0 && (!root[F("width")].isNull() || !root[F("height")].isNull())) {
-    Segment::maxWidth  = min(max(root[F("width")].as<int>(), 1), 128);
-    Segment::maxHeight = min(max(root[F("height")].as<int>(), 1), 128);
+  if (!table) {
+    DEBUG_PRINTLN(F("ERROR LED map allocation error."));
+    customMappingSize = 0;
+    currentLedmap = 0;
+    return false;
   }
 
-  if (customMappingTable) free(customMappingTable);
-  customMappingTable = static_cast<uint16_t*>(malloc(sizeof(uint16_t)*getLengthTotal()));
-
-  if (customMappingTable) {
-    DEBUG_PRINT(F("Reading LED map from ")); DEBUG_PRINTLN(fileName);
+  unsigned count = 0;
+  uint16_t width = 0, height = 0, entries = 0;
+  ledmap_cache_entry_t *cached = findCachedLedmap(n, len);
+  if (cached) {
+    LedmapReader in(cached->data, cached->size);
+    if (readLedmapHeader(in, width, height, entries, nullptr, 0)) count = decodeLedmap(in, entries, table, len);
+    cached->lastUsed = ++ledmapCacheUse;
+  } else if (isBinary) {
+    DEBUG_PRINT(F("Reading binary LED map from ")); DEBUG_PRINTLN(fileName);
     File f = WLED_FS.open(fileName, "r");
-    f.find("\"map\":[");
-    while (f.available()) { // f.position() < f.size() - 1
-      char number[32];
-      size_t numRead = f.readBytesUntil(',', number, sizeof(number)-1); // read a single number (may include array terminating "]" but not number separator ',')
-      number[numRead] = 0;
-      if (numRead > 0) {
-        char *end = strchr(number,']'); // we encountered end of array so stop processing if no digit found
-        bool foundDigit = (end == nullptr);
-        int i = 0;
-        if (end != nullptr) do {
-          if (number[i] >= '0' && number[i] <= '9') foundDigit = true;
-          if (foundDigit || &number[i++] == end) break;
-        } while (i < 32);
-        if (!foundDigit) break;
-        int index = atoi(number);
-        if (index < 0 || index > 16384) index = 0xFFFF;
-        customMappingTable[customMappingSize++] = index;
-        if (customMappingSize > getLengthTotal()) break;
-      } else break; // there was nothing to read, stop
-    }
-    currentLedmap = n;
+    LedmapReader in(&f);
+    if (readLedmapHeader(in, width, height, entries, nullptr, 0)) count = decodeLedmap(in, entries, table, len);
     f.close();
-
-    #ifdef WLED_DEBUG
-    DEBUG_PRINT(F("Loaded ledmap:"));
-    for (unsigned i=0; i<customMappingSize; i++) {
-      if (!(i%Segment::maxWidth)) DEBUG_PRINTLN();
-      DEBUG_PRINTF_P(PSTR("%4d,"), customMappingTable[i]);
+  } else if (requestJSONBufferLock(7)) {
+    StaticJsonDocument<64> filter;
+    filter[F("width")]  = true;
+    filter[F("height")] = true;
+    bool valid = readObjectFromFile(fileName, nullptr, pDoc, &filter);
+    if (valid) {
+      width  = (*pDoc)[F("width")]  | 0;
+      height = (*pDoc)[F("height")] | 0;
     }
-    DEBUG_PRINTLN();
-    #endif
-/*
-    JsonArray map = root[F("map")];
-    if (!map.isNull() && map.size()) {  // not an empty map
-      customMappingSize = min((unsigned)map.size(), (unsigned)getLengthTotal());
-      for (unsigned i=0; i<customMappingSize; i++) customMappingTable[i] = (uint16_t) (map[i]<0 ? 0xFFFFU : map[i]);
-      currentLedmap = n;
+    releaseJSONBufferLock();
+    if (valid) {
+      DEBUG_PRINT(F("Reading LED map from ")); DEBUG_PRINTLN(fileName);
+      File f = WLED_FS.open(fileName, "r");
+      count = readJsonLedmap(f, table, len);
+      f.close();
+    } else {
+      DEBUG_PRINT(F("ERROR Invalid ledmap in ")); DEBUG_PRINTLN(fileName);
+    }
+  }
+
+  if (count && !cached) { // keep the map encoded for the next switch to it
+    size_t size = encodeLedmap(table, count, width, height, nullptr);
+    uint8_t *data = size <= WLED_LEDMAP_CACHE_BYTES ? static_cast<uint8_t*>(malloc(size)) : nullptr;
+    if (data) {
+      encodeLedmap(table, count, width, height, data);
+      cacheLedmap(n, len, data, size);
     }
-*/
-  } else {
-    DEBUG_PRINTLN(F("ERROR LED map allocation error."));
   }
 
+  #ifdef WLED_DEBUG
+  DEBUG_PRINT(F("Loaded ledmap:"));
+  for (unsigned i=0; i<count; i++) {
+    if (!(i%Segment::maxWidth)) DEBUG_PRINTLN();
+    DEBUG_PRINTF_P(PSTR("%4d,"), table[i]);
+  }
+  DEBUG_PRINTLN();
+  #endif
+
+  suspend();
+  // if we are loading default ledmap (at boot) set matrix width and height from the ledmap (compatible with WLED MM ledmaps)
+  if (isMatrix && n == 0 && (width || height)) {
+    Segment::maxWidth  = min(max((int)width,  1), 128);
+    Segment::maxHeight = min(max((int)height, 1), 128);
+  }
+  clearMapping();
+  customMappingTable = table;
+  customMappingSize = count;
+  compactMapping();
+  currentLedmap = count ? n : 0;
   resume();
 
-  releaseJSONBufferLock();
   return (customMappingSize > 0);
 }
 
@@ -72,11 +72,7 @@ void ParticleSystem2D::update(void) {
   if (particlesettings.useCollisions)
     handleCollisions();
 
-  //move all particles
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr); // note: splitting this into two loops is slower and uses more flash
-  }
-
+  moveParticles();
   render();
 }
 
@@ -224,13 +220,33 @@ int32_t ParticleSystem2D::angleEmit(PSsource &emitter, const uint16_t angle, con
 // particle moves, decays and dies, if killoutofbounds is set, out of bounds particles are set to ttl=0
 // uses passed settings to set bounce or wrap, if useGravity is enabled, it will never bounce at the top and killoutofbounds is not applied over the top
 void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &partFlags, PSsettings2D *options, PSadvancedParticle *advancedproperties) {
-  if (options == nullptr)
-    options = &particlesettings; //use PS system settings by default
+  moveParticle(part, partFlags, options ? *options : particlesettings, advancedproperties);
+}
 
+// move all used particles using system settings
+// batched version of particleMoveUpdate(): settings are passed by value and the loop is split for basic and advanced particles,
+// so the compiler can specialize the inlined move for each case instead of branching on pointers for every particle
+void ParticleSystem2D::moveParticles() {
+  const PSsettings2D options = particlesettings;
+  if (advPartProps) {
+    for (uint32_t i = 0; i < usedParticles; i++) {
+      if (particles[i].ttl == 0) continue; // dead particles cost nothing but this check
+      moveParticle(particles[i], particleFlags[i], options, &advPartProps[i]);
+    }
+  } else {
+    for (uint32_t i = 0; i < usedParticles; i++) {
+      if (particles[i].ttl == 0) continue;
+      moveParticle(particles[i], particleFlags[i], options, nullptr);
+    }
+  }
+}
+
+// move a single particle, see particleMoveUpdate()
+void ParticleSystem2D::moveParticle(PSparticle &part, PSparticleFlags &partFlags, const PSsettings2D options, PSadvancedParticle *advancedproperties) {
   if (part.ttl > 0) {
     if (!partFlags.perpetual)
       part.ttl--; // age
-    if (options->colorByAge)
+    if (options.colorByAge)
       part.hue = min(part.ttl, (uint16_t)255); //set color to ttl
 
     int32_t renderradius = PS_P_HALFRADIUS; // used to check out of bounds
@@ -246,30 +262,30 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
       }
     }
     // note: if wall collisions are enabled, bounce them before they reach the edge, it looks much nicer if the particle does not go half out of view
-    if (options->bounceY) {
-      if ((newY < (int32_t)particleHardRadius) || ((newY > (int32_t)(maxY - particleHardRadius)) && !options->useGravity)) { // reached floor / ceiling
+    if (options.bounceY) {
+      if ((newY < (int32_t)particleHardRadius) || ((newY > (int32_t)(maxY - particleHardRadius)) && !options.useGravity)) { // reached floor / ceiling
          bounce(part.vy, part.vx, newY, maxY);
       }
     }
 
-    if (!checkBoundsAndWrap(newY, maxY, renderradius, options->wrapY)) { // check out of bounds  note: this must not be skipped. if gravity is enabled, particles will never bounce at the top
+    if (!checkBoundsAndWrap(newY, maxY, renderradius, options.wrapY)) { // check out of bounds  note: this must not be skipped. if gravity is enabled, particles will never bounce at the top
       partFlags.outofbounds = true;
-      if (options->killoutofbounds) {
+      if (options.killoutofbounds) {
         if (newY < 0) // if gravity is enabled, only kill particles below ground
           part.ttl = 0;
-        else if (!options->useGravity)
+        else if (!options.useGravity)
           part.ttl = 0;
       }
     }
 
     if (part.ttl) { //check x direction only if still alive
-      if (options->bounceX) {
+      if (options.bounceX) {
         if ((newX < (int32_t)particleHardRadius) || (newX > (int32_t)(maxX - particleHardRadius))) // reached a wall
           bounce(part.vx, part.vy, newX, maxX);
       }
-      else if (!checkBoundsAndWrap(newX, maxX, renderradius, options->wrapX)) { // check out of bounds
+      else if (!checkBoundsAndWrap(newX, maxX, renderradius, options.wrapX)) { // check out of bounds
         partFlags.outofbounds = true;
-        if (options->killoutofbounds)
+        if (options.killoutofbounds)
           part.ttl = 0;
       }
     }
@@ -435,15 +451,18 @@ void ParticleSystem2D::applyForce(const uint32_t particleindex, const int8_t xfo
 
 // apply a force in x,y direction to all particles
 // force is in 3.4 fixed point notation (see above)
+// all particles share the global force counter, so the velocity change is calculated once and applied in a tight loop
 void ParticleSystem2D::applyForce(const int8_t xforce, const int8_t yforce) {
-  // for small forces, need to use a delay counter
-  uint8_t tempcounter;
-  // note: this is not the most computationally efficient way to do this, but it saves on duplicate code and is fast enough
+  uint8_t xcounter = forcecounter & 0x0F; // lower four bits
+  uint8_t ycounter = forcecounter >> 4;   // upper four bits
+  int32_t dvx = calcForce_dv(xforce, xcounter);
+  int32_t dvy = calcForce_dv(yforce, ycounter);
+  forcecounter = (xcounter & 0x0F) | ((ycounter << 4) & 0xF0); // save counters back
+  if (dvx == 0 && dvy == 0) return;
   for (uint32_t i = 0; i < usedParticles; i++) {
-    tempcounter = forcecounter;
-    applyForce(particles[i], xforce, yforce, tempcounter);
+    particles[i].vx = limitSpeed((int32_t)particles[i].vx + dvx);
+    particles[i].vy = limitSpeed((int32_t)particles[i].vy + dvy);
   }
-  forcecounter = tempcounter; // save value back
 }
 
 // apply a force in angular direction to single particle
@@ -784,10 +803,103 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
 }
 
 // detect collisions in an array of particles and handle them
+// uses a uniform grid built once per frame: colliding particles are counting-sorted into square cells that are at least as wide as the largest
+// collision distance, so a particle can only touch particles in its own or one of the 8 neighbouring cells. each cell is checked against itself
+// and its 4 'forward' neighbours, so every close pair is tested exactly once and all collisions are handled every frame in O(n)
+// note: cells are binned by lookahead position (position + speed), the same position the distance check uses
+void ParticleSystem2D::handleCollisions() {
+  if (advPartProps) // may be using individual particle size
+    setParticleSize(particlesize); // updates base particleHardRadius (particleMoveUpdate() changes it for individually sized particles)
+  uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
+  uint32_t maxCollDist = collDistSq;
+  if (advPartProps)
+    maxCollDist += 255; // individual sizes add at most (255 + 255) >> 1, see below
+  collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
+
+  // cell size is a power of 2 so the cell index is a shift. use a coarser grid if it would have more cells than particles: keeps scratch memory and the cell scan O(n)
+  uint32_t shift = PS_P_RADIUS_SHIFT;
+  while ((1U << shift) < maxCollDist) shift++;
+  const uint32_t maxCells = max(usedParticles, (uint32_t)64);
+  while ((uint32_t)((maxX >> shift) + 1) * (uint32_t)((maxY >> shift) + 1) > maxCells) shift++;
+  const int32_t cellsX = (maxX >> shift) + 1;
+  const int32_t cellsY = (maxY >> shift) + 1;
+  const uint32_t numCells = cellsX * cellsY;
+
+  // scratch memory: cell start indices (numCells + 1) followed by the sorted particle indices, 6kB max for 2048 particles
+  uint16_t *cellStart = static_cast<uint16_t*>(malloc((numCells + 1 + usedParticles) * sizeof(uint16_t)));
+  if (!cellStart) { // low on heap, use the slower binning that needs no scratch memory
+    handleCollisionsBinned();
+    return;
+  }
+  uint16_t *cellParticles = cellStart + numCells + 1;
+
+  // returns the grid cell of a particle or -1 if it does not take part in collisions. positions are clamped to the grid, this can only merge cells
+  auto cellOf = [&](uint32_t i) -> int32_t {
+    if (particles[i].ttl == 0 || particleFlags[i].outofbounds || !particleFlags[i].collide) return -1;
+    int32_t cx = (particles[i].x + particles[i].vx) >> shift;
+    int32_t cy = (particles[i].y + particles[i].vy) >> shift;
+    cx = cx < 0 ? 0 : (cx >= cellsX ? cellsX - 1 : cx);
+    cy = cy < 0 ? 0 : (cy >= cellsY ? cellsY - 1 : cy);
+    return cx + cy * cellsX;
+  };
+
+  // counting sort: count particles per cell, prefix sum to cell end indices, then fill backwards which leaves cellStart[] at each cell's start
+  memset(cellStart, 0, (numCells + 1) * sizeof(uint16_t));
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    int32_t cell = cellOf(i);
+    if (cell >= 0) cellStart[cell]++;
+  }
+  uint32_t sum = 0;
+  for (uint32_t c = 0; c <= numCells; c++) {
+    sum += cellStart[c];
+    cellStart[c] = sum;
+  }
+  for (int32_t i = usedParticles - 1; i >= 0; i--) {
+    int32_t cell = cellOf(i);
+    if (cell >= 0) cellParticles[--cellStart[cell]] = i;
+  }
+
+  // check a particle against a range of sorted particles
+  auto collideRange = [&](uint32_t idx_i, uint32_t from, uint32_t to) {
+    for (uint32_t j = from; j < to; j++) {
+      uint32_t idx_j = cellParticles[j];
+      if (advPartProps) { //may be using individual particle size
+        collDistSq = (particleHardRadius << 1) + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
+        collDistSq = collDistSq * collDistSq; // square it for faster comparison
+      }
+      int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
+      if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
+        int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
+        if (dy * dy < collDistSq) // particles are close
+          collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
+      }
+    }
+  };
+
+  for (int32_t cy = 0; cy < cellsY; cy++) {
+    for (int32_t cx = 0; cx < cellsX; cx++) {
+      const uint32_t cell = cx + cy * cellsX;
+      const uint32_t start = cellStart[cell];
+      const uint32_t end = cellStart[cell + 1];
+      if (start == end) continue; // empty cell
+      for (uint32_t i = start; i < end; i++) {
+        const uint32_t idx_i = cellParticles[i];
+        collideRange(idx_i, i + 1, end); // 'higher number' particles in the same cell
+        if (cx + 1 < cellsX) collideRange(idx_i, cellStart[cell + 1], cellStart[cell + 2]); // right
+        if (cy + 1 < cellsY) {
+          const uint32_t above = cell + cellsX;
+          collideRange(idx_i, cellStart[cx > 0 ? above - 1 : above], cellStart[cx + 1 < cellsX ? above + 2 : above + 1]); // above left, above and above right are consecutive
+        }
+      }
+    }
+  }
+  free(cellStart);
+}
+
+// fallback collision detection if there is not enough heap for the grid (see above)
 // uses binning by dividing the frame into slices in x direction which is efficient if using gravity in y direction (but less efficient for FX that use forces in x direction)
 // for code simplicity, no y slicing is done, making very tall matrix configurations less efficient
-// note: also tested adding y slicing, it gives diminishing returns, some FX even get slower. FX not using gravity would benefit with a 10% FPS improvement
-void ParticleSystem2D::handleCollisions() {
+void ParticleSystem2D::handleCollisionsBinned() {
   uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
   collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
   // note: partices are binned in x-axis, assumption is that no more than half of the particles are in the same bin
@@ -186,12 +186,18 @@ public:
   //note: some variables are 32bit for speed and code size at the cost of ram
 
 private:
+#ifdef WLED_NATIVE
+  friend struct PSCollisionBench; // tools/native/ps_bench.cpp
+#endif
   //rendering functions
   void render();
   [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGB& color, const bool wrapX, const bool wrapY);
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
+  void moveParticles(); // moves all particles using system settings
+  [[gnu::always_inline]] inline void moveParticle(PSparticle &part, PSparticleFlags &partFlags, const PSsettings2D options, PSadvancedParticle *advancedproperties);
   void handleCollisions();
+  void handleCollisionsBinned(); // fallback if there is no heap for the collision grid
   [[gnu::hot]] void collideParticles(PSparticle &particle1, PSparticle &particle2, const int32_t dx, const int32_t dy, const uint32_t collDistSq);
   void fireParticleupdate();
   //utility functions
@@ -208,7 +214,7 @@ private:
   uint32_t wallHardness;
   uint32_t wallRoughness; // randomizes wall collisions  
   uint32_t particleHardRadius; // hard surface radius of a particle, used for collision detection (32bit for speed)
-  uint16_t collisionStartIdx; // particle array start index for collision detection
+  uint16_t collisionStartIdx; // particle array start index for binned collision detection
   uint8_t fireIntesity = 0; // fire intensity, used for fire mode (flash use optimization, better than passing an argument to render function)
   uint8_t forcecounter; // counter for globally applied forces
   uint8_t gforcecounter; // counter for global gravity
@@ -22,7 +22,11 @@
 #include "const.h"
 #include "pin_manager.h"
 #include "bus_manager.h"
+#ifndef WLED_NATIVE
 #include "bus_wrapper.h"
+#else
+#include "bus_wrapper_native.h" // in-memory PolyBus for host builds (tools/native)
+#endif
 #include <bits/unique_ptr.h>
 
 extern bool cctICused;
@@ -32,7 +36,8 @@ extern bool useParallelI2S;
 uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb);
 
 //udp.cpp
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false, uint16_t startUniverse=1);
+void realtimeBroadcastSync();
 
 
 //color mangling macros
@@ -106,6 +111,8 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 , _colorOrder(bc.colorOrder)
 , _milliAmpsPerLed(bc.milliAmpsPerLed)
 , _milliAmpsMax(bc.milliAmpsMax)
+, _milliAmpsTotal(0)
+, _colorSum(0)
 , _data(nullptr)
 {
   DEBUGBUS_PRINTLN(F("Bus: Creating digital bus."));
@@ -147,6 +154,12 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
   );
 }
 
+// power units of a pixel used by estimateCurrentAndLimitBri(), i.e. the sum of its channels
+inline uint32_t BusDigital::pixelPower(uint32_t c) const {
+  if (_milliAmpsPerLed == 255) return max(max(R(c),G(c)),B(c)) * 3; //ignore white component on WS2815 power calculation
+  return R(c) + G(c) + B(c) + W(c);
+}
+
 //DISCLAIMER
 //The following function attemps to calculate the current LED power usage,
 //and will limit the brightness to stay below a set amperage threshold.
@@ -155,16 +168,14 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 //I am NOT to be held liable for burned down garages or houses!
 
 // To disable brightness limiter we either set output max current to 0 or single LED current to 0
-uint8_t BusDigital::estimateCurrentAndLimitBri() const {
-  bool useWackyWS2815PowerModel = false;
+uint8_t BusDigital::estimateCurrentAndLimitBri() {
   byte actualMilliampsPerLed = _milliAmpsPerLed;
 
   if (_milliAmpsMax < MA_FOR_ESP/BusManager::getNumBusses() || actualMilliampsPerLed == 0) { //0 mA per LED and too low numbers turn off calculation
     return _bri;
   }
 
-  if (_milliAmpsPerLed == 255) {
-    useWackyWS2815PowerModel = true;
+  if (_milliAmpsPerLed == 255) { // wacky WS2815 power model (see pixelPower())
     actualMilliampsPerLed = 12; // from testing an actual strip
   }
 
@@ -175,15 +186,11 @@ uint8_t BusDigital::estimateCurrentAndLimitBri() const {
     powerBudget = 0;
   }
 
-  uint32_t busPowerSum = 0;
-  for (unsigned i = 0; i < getLength(); i++) {  //sum up the usage of each LED
-    uint32_t c = getPixelColor(i); // always returns original or restored color without brightness scaling
-    byte r = R(c), g = G(c), b = B(c), w = W(c);
-
-    if (useWackyWS2815PowerModel) { //ignore white component on WS2815 power calculation
-      busPowerSum += (max(max(r,g),b)) * 3;
-    } else {
-      busPowerSum += (r + g + b + w);
+  uint32_t busPowerSum = _colorSum; // with a buffer the sum is kept up to date as pixels are set
+  if (!_data) {
+    busPowerSum = 0;
+    for (unsigned i = 0; i < getLength(); i++) {  //sum up the usage of each LED
+      busPowerSum += pixelPower(getPixelColor(i)); // always returns restored color without brightness scaling
     }
   }
 
@@ -193,21 +200,21 @@ uint8_t BusDigital::estimateCurrentAndLimitBri() const {
   }
 
   // powerSum has all the values of channels summed (max would be getLength()*765 as white is excluded) so convert to milliAmps
-  BusDigital::_milliAmpsTotal = (busPowerSum * actualMilliampsPerLed * _bri) / (765*255);
+  _milliAmpsTotal = (busPowerSum * actualMilliampsPerLed * _bri) / (765*255);
 
   uint8_t newBri = _bri;
-  if (BusDigital::_milliAmpsTotal > powerBudget) {
+  if (_milliAmpsTotal > powerBudget) {
     //scale brightness down to stay in current limit
-    unsigned scaleB = powerBudget * 255 / BusDigital::_milliAmpsTotal;
+    unsigned scaleB = powerBudget * 255 / _milliAmpsTotal;
     newBri = (_bri * scaleB) / 256 + 1;
-    BusDigital::_milliAmpsTotal = powerBudget;
+    _milliAmpsTotal = powerBudget;
     //_milliAmpsTotal = (busPowerSum * actualMilliampsPerLed * newBri) / (765*255);
   }
   return newBri;
 }
 
 void BusDigital::show() {
-  BusDigital::_milliAmpsTotal = 0;
+  _milliAmpsTotal = 0;
   if (!_valid) return;
 
   uint8_t cctWW = 0, cctCW = 0;
@@ -262,6 +269,7 @@ void BusDigital::show() {
     }
   }
   PolyBus::show(_busPtr, _iType, !_data); // faster if buffer consistency is not important
+  _dirty = false;
   // restore bus brightness to its original value
   // this is done right after show, so this is only OK if LED updates are completed before show() returns
   // or async show has a separate buffer (ESP32 RMT and I2S are ok)
@@ -285,6 +293,7 @@ void BusDigital::setStatusPixel(uint32_t c) {
   if (_valid && _skip) {
     PolyBus::setPixelColor(_busPtr, _iType, 0, c, _colorOrderMap.getPixelColorOrder(_start, _colorOrder));
     if (canShow()) PolyBus::show(_busPtr, _iType);
+    _dirty = true; // next show() paints the status pixel black again
   }
 }
 
@@ -295,6 +304,13 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   if (_data) {
     size_t offset = pix * getNumberOfChannels();
     uint8_t* dataptr = _data + offset;
+    // compare with buffer content (colors as getPixelColor() returns them): change detection and ABL power sum
+    const uint32_t cOld = hasRGB() ? RGBW32(dataptr[0], dataptr[1], dataptr[2], hasWhite() ? dataptr[3] : 0) : RGBW32(dataptr[0], dataptr[0], dataptr[0], dataptr[0]);
+    const uint32_t cNew = hasRGB() ? (hasWhite() ? c : c & 0x00FFFFFF) : RGBW32(W(c), W(c), W(c), W(c));
+    if (cNew != cOld) {
+      if (_milliAmpsPerLed) _colorSum += pixelPower(cNew) - pixelPower(cOld); // ABL: replace the pixel's share of the sum
+      _dirty = true;
+    }
     if (hasRGB()) {
       *dataptr++ = R(c);
       *dataptr++ = G(c);
@@ -303,8 +319,13 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
     if (hasWhite()) *dataptr++ = W(c);
     // unfortunately as a segment may span multiple buses or a bus may contain multiple segments and each segment may have different CCT
     // we need to store CCT value for each pixel (if there is a color correction in play, convert K in CCT ratio)
-    if (hasCCT()) *dataptr = Bus::_cct >= 1900 ? (Bus::_cct - 1900) >> 5 : (Bus::_cct < 0 ? 127 : Bus::_cct); // TODO: if _cct == -1 we simply ignore it
+    if (hasCCT()) {
+      uint8_t cct = Bus::_cct >= 1900 ? (Bus::_cct - 1900) >> 5 : (Bus::_cct < 0 ? 127 : Bus::_cct); // TODO: if _cct == -1 we simply ignore it
+      _dirty |= (*dataptr != cct);
+      *dataptr = cct;
+    }
   } else {
+    _dirty = true; // no buffer to compare with
     if (_reversed) pix = _len - pix -1;
     pix += _skip;
     unsigned co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
@@ -329,6 +350,37 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   }
 }
 
+// same as setPixelColor() for a run of pixels: RGB(W) buses with a buffer decide the per-pixel conversion once per run
+void IRAM_ATTR BusDigital::setPixelColors(unsigned pix, const uint32_t *c, unsigned len) {
+  if (!_valid || !_data || !hasRGB() || hasCCT()) {
+    for (unsigned i = 0; i < len; i++) setPixelColor(pix + i, c[i]);
+    return;
+  }
+  const bool white = hasWhite();
+  const bool balance = Bus::_cct >= 1900;
+  const bool abl = _milliAmpsPerLed;
+  uint8_t *dataptr = _data + pix * getNumberOfChannels();
+  uint32_t colorSum = _colorSum;
+  bool changed = false;
+  for (unsigned i = 0; i < len; i++) {
+    uint32_t col = c[i];
+    if (white) col = autoWhiteCalc(col);
+    if (balance) col = colorBalanceFromKelvin(Bus::_cct, col); //color correction from CCT
+    const uint32_t cOld = RGBW32(dataptr[0], dataptr[1], dataptr[2], white ? dataptr[3] : 0);
+    if (!white) col &= 0x00FFFFFF;
+    if (col != cOld) {
+      if (abl) colorSum += pixelPower(col) - pixelPower(cOld);
+      changed = true;
+    }
+    *dataptr++ = R(col);
+    *dataptr++ = G(col);
+    *dataptr++ = B(col);
+    if (white) *dataptr++ = W(col);
+  }
+  _colorSum = colorSum;
+  if (changed) _dirty = true;
+}
+
 // returns original color if global buffering is enabled, else returns lossly restored color from bus
 uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
@@ -720,6 +772,7 @@ BusNetwork::BusNetwork(const BusConfig &bc)
       _UDPtype = 2;
       break;
     case TYPE_NET_E131_RGB:
+    case TYPE_NET_E131_RGBW:
       _UDPtype = 1;
       break;
     default: // TYPE_NET_DDP_RGB / TYPE_NET_DDP_RGBW
@@ -731,6 +784,7 @@ BusNetwork::BusNetwork(const BusConfig &bc)
   _hasCCT = false;
   _UDPchannels = _hasWhite + 3;
   _client = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
+  _universe = bc.universe;
   _data = (uint8_t*)calloc(_len, _UDPchannels);
   _valid = (_data != nullptr);
   DEBUGBUS_PRINTF_P(PSTR("%successfully inited virtual strip with type %u and IP %u.%u.%u.%u\n"), _valid?"S":"Uns", bc.type, bc.pins[0], bc.pins[1], bc.pins[2], bc.pins[3]);
@@ -741,12 +795,35 @@ void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
   if (_hasWhite) c = autoWhiteCalc(c);
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
   unsigned offset = pix * _UDPchannels;
+  if (!_hasWhite) c &= 0x00FFFFFF;
+  if (c == RGBW32(_data[offset], _data[offset+1], _data[offset+2], _hasWhite ? _data[offset+3] : 0)) return; // unchanged
+  _dirty = true;
   _data[offset]   = R(c);
   _data[offset+1] = G(c);
   _data[offset+2] = B(c);
   if (_hasWhite) _data[offset+3] = W(c);
 }
 
+// same as setPixelColor() for a run of pixels, with the checks done once per run
+void BusNetwork::setPixelColors(unsigned pix, const uint32_t *c, unsigned len) {
+  if (!_valid || pix >= _len) return;
+  if (len > _len - pix) len = _len - pix;
+  const bool balance = Bus::_cct >= 1900;
+  uint8_t *dataptr = _data + pix * _UDPchannels;
+  uint8_t changed = 0;
+  for (unsigned i = 0; i < len; i++) {
+    uint32_t col = c[i];
+    if (_hasWhite) col = autoWhiteCalc(col);
+    if (balance) col = colorBalanceFromKelvin(Bus::_cct, col); //color correction from CCT
+    changed |= (dataptr[0] ^ R(col)) | (dataptr[1] ^ G(col)) | (dataptr[2] ^ B(col));
+    *dataptr++ = R(col);
+    *dataptr++ = G(col);
+    *dataptr++ = B(col);
+    if (_hasWhite) { changed |= *dataptr ^ W(col); *dataptr++ = W(col); }
+  }
+  if (changed) _dirty = true;
+}
+
 uint32_t BusNetwork::getPixelColor(unsigned pix) const {
   if (!_valid || pix >= _len) return 0;
   unsigned offset = pix * _UDPchannels;
@@ -756,8 +833,9 @@ uint32_t BusNetwork::getPixelColor(unsigned pix) const {
 void BusNetwork::show() {
   if (!_valid || !canShow()) return;
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite());
+  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite(), _universe);
   _broadcastLock = false;
+  _dirty = false;
 }
 
 unsigned BusNetwork::getPins(uint8_t* pinArray) const {
@@ -769,8 +847,10 @@ unsigned BusNetwork::getPins(uint8_t* pinArray) const {
 std::vector<LEDType> BusNetwork::getLEDTypes() {
   return {
     {TYPE_NET_DDP_RGB,     "N",     PSTR("DDP RGB (network)")},      // should be "NNNN" to determine 4 "pin" fields
+    {TYPE_NET_E131_RGB,    "N",     PSTR("E1.31 RGB (network)")},
     {TYPE_NET_ARTNET_RGB,  "N",     PSTR("Art-Net RGB (network)")},
     {TYPE_NET_DDP_RGBW,    "N",     PSTR("DDP RGBW (network)")},
+    {TYPE_NET_E131_RGBW,   "N",     PSTR("E1.31 RGBW (network)")},
     {TYPE_NET_ARTNET_RGBW, "N",     PSTR("Art-Net RGBW (network)")},
     // hypothetical extensions
     //{TYPE_VIRTUAL_I2C_W,   "V",     PSTR("I2C White (virtual)")}, // allows setting I2C address in _pin[0]
@@ -803,7 +883,7 @@ unsigned BusConfig::memUsage(unsigned nr) const {
 }
 
 
-unsigned BusManager::memUsage() {
+size_t BusManager::memUsage() {
   // when ESP32, S2 & S3 use parallel I2S only the largest bus determines the total memory requirements for back buffers
   // front buffers are always allocated per bus
   unsigned size = 0;
@@ -849,6 +929,7 @@ int BusManager::add(const BusConfig &bc) {
     busses.push_back(make_unique<BusPwm>(bc));
     //busses.push_back(new BusPwm(bc));
   }
+  updateBusMap();
   return busses.size();
 }
 
@@ -893,9 +974,32 @@ void BusManager::removeAll() {
   while (!canAllShow()) yield();
   //for (auto &bus : busses) delete bus; // needed when not using std::unique_ptr C++ >11
   busses.clear();
+  updateBusMap();
   PolyBus::setParallelI2S1Output(false);
 }
 
+// (re)build the logical pixel to bus lookup so setPixelColor()/getPixelColor() do not need to scan all busses
+// one byte per pixel; pixels covered by several busses are marked and resolved by scanning (rare, mirrored outputs)
+void BusManager::updateBusMap() {
+  unsigned len = 0;
+  for (const auto &bus : busses) len = std::max(len, (unsigned)bus->getStart() + bus->getLength());
+  _busMap.assign(len, BUSMAP_NONE);
+  _busMap.shrink_to_fit();
+  _busMapOverlap = false;
+  for (size_t b = 0; b < busses.size() && b < BUSMAP_MULTI; b++) {
+    unsigned start = busses[b]->getStart();
+    unsigned end   = start + busses[b]->getLength();
+    for (unsigned i = start; i < end; i++) {
+      if (_busMap[i] == BUSMAP_NONE) _busMap[i] = b;
+      else {
+        _busMap[i] = BUSMAP_MULTI;
+        _busMapOverlap = true;
+      }
+    }
+  }
+  DEBUGBUS_PRINTF_P(PSTR("Bus: Pixel map %u entries%s.\n"), len, _busMapOverlap ? " (overlapping)" : "");
+}
+
 #ifdef ESP32_DATA_IDLE_HIGH
 // #2478
 // If enabled, RMT idle level is set to HIGH when off
@@ -970,19 +1074,56 @@ void BusManager::off() {
   #endif
 }
 
+// busses whose output has not changed since they were last sent are skipped (they keep their used current),
+// except for chipsets and outputs that need a continuous refresh; all busses are re-sent every _keepAliveMs
+// (i.e. for network receivers with a timeout, or LEDs that lost their state due to a glitch)
 void BusManager::show() {
+  const unsigned long now = millis();
+  const bool keepAlive = now - _lastKeepAlive >= _keepAliveMs;
+  if (keepAlive) _lastKeepAlive = now;
   _gMilliAmpsUsed = 0;
   for (auto &bus : busses) {
-    bus->show();
+    if (keepAlive || bus->isDirty() || bus->mustRefresh() || bus->isOffRefreshRequired()) bus->show();
     _gMilliAmpsUsed += bus->getUsedCurrent();
   }
+  realtimeBroadcastSync(); // let network receivers latch the frame
 }
 
 void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
-  for (auto &bus : busses) {
-    unsigned bstart = bus->getStart();
-    if (pix < bstart || pix >= bstart + bus->getLength()) continue;
-    bus->setPixelColor(pix - bstart, c);
+  if (pix >= _busMap.size()) return;
+  unsigned b = _busMap[pix];
+  if (b < BUSMAP_MULTI) {
+    Bus *bus = busses[b].get();
+    bus->setPixelColor(pix - bus->getStart(), c);
+  } else if (b == BUSMAP_MULTI) {
+    for (auto &bus : busses) {
+      unsigned bstart = bus->getStart();
+      if (pix < bstart || pix >= bstart + bus->getLength()) continue;
+      bus->setPixelColor(pix - bstart, c);
+    }
+  }
+}
+
+void IRAM_ATTR BusManager::setPixelColors(unsigned pix, const uint32_t *c, unsigned len) {
+  while (len > 0 && pix < _busMap.size()) {
+    unsigned b = _busMap[pix];
+    unsigned n = 1;
+    if (b < BUSMAP_MULTI) {
+      Bus *bus = busses[b].get();
+      unsigned bstart = bus->getStart();
+      n = std::min(len, bstart + bus->getLength() - pix);
+      if (_busMapOverlap) { // stop the run where another bus overlaps
+        unsigned k = 1;
+        while (k < n && _busMap[pix + k] == b) k++;
+        n = k;
+      }
+      bus->setPixelColors(pix - bstart, c, n);
+    } else if (b == BUSMAP_MULTI) {
+      setPixelColor(pix, *c);
+    }
+    pix += n;
+    c   += n;
+    len -= n;
   }
 }
 
@@ -996,6 +1137,13 @@ void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
 }
 
 uint32_t BusManager::getPixelColor(unsigned pix) {
+  if (pix >= _busMap.size()) return 0;
+  unsigned b = _busMap[pix];
+  if (b < BUSMAP_MULTI) {
+    const Bus *bus = busses[b].get();
+    return bus->getPixelColor(pix - bus->getStart());
+  }
+  if (b == BUSMAP_NONE) return 0;
   for (auto &bus : busses) {
     unsigned bstart = bus->getStart();
     if (!bus->containsPixel(pix)) continue;
@@ -1019,9 +1167,11 @@ int16_t Bus::_cct = -1;
 uint8_t Bus::_cctBlend = 0;
 uint8_t Bus::_gAWM = 255;
 
-uint16_t BusDigital::_milliAmpsTotal = 0;
-
 std::vector<std::unique_ptr<Bus>> BusManager::busses;
 //std::vector<Bus*> BusManager::busses;
 uint16_t BusManager::_gMilliAmpsUsed = 0;
 uint16_t BusManager::_gMilliAmpsMax = ABL_MILLIAMPS_DEFAULT;
+uint16_t BusManager::_keepAliveMs = BUS_KEEPALIVE_DEFAULT;
+unsigned long BusManager::_lastKeepAlive = 0;
+std::vector<uint8_t> BusManager::_busMap;
+bool BusManager::_busMapOverlap = false;
@@ -110,6 +110,7 @@ class Bus {
     , _reversed(reversed)
     , _valid(false)
     , _needsRefresh(refresh)
+    , _dirty(true)
     {
       _autoWhiteMode = Bus::hasWhite(type) ? aw : RGBW_MODE_MANUAL_ONLY;
     };
@@ -121,7 +122,8 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c) = 0;
-    virtual void     setBrightness(uint8_t b)                   { _bri = b; };
+    virtual void     setPixelColors(unsigned pix, const uint32_t *c, unsigned len) { for (unsigned i = 0; i < len; i++) setPixelColor(pix + i, c[i]); } // span must fit the bus
+    virtual void     setBrightness(uint8_t b)                   { _dirty |= (_bri != b); _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
     virtual unsigned getPins(uint8_t* pinArray = nullptr) const { return 0; }
@@ -129,6 +131,7 @@ class Bus {
     virtual uint8_t  getColorOrder() const                      { return COL_ORDER_RGB; }
     virtual unsigned skippedLeds() const                        { return 0; }
     virtual uint16_t getFrequency() const                       { return 0U; }
+    virtual uint16_t getUniverse() const                        { return 0U; }
     virtual uint16_t getLEDCurrent() const                      { return 0; }
     virtual uint16_t getUsedCurrent() const                     { return 0; }
     virtual uint16_t getMaxCurrent() const                      { return 0; }
@@ -154,6 +157,7 @@ class Bus {
     inline  bool     isOk() const                               { return _valid; }
     inline  bool     isReversed() const                         { return _reversed; }
     inline  bool     isOffRefreshRequired() const               { return _needsRefresh; }
+    inline  bool     isDirty() const                            { return _dirty; }
     inline  bool     containsPixel(uint16_t pix) const          { return pix >= _start && pix < _start + _len; }
 
     static inline std::vector<LEDType> getLEDTypes()            { return {{TYPE_NONE, "", PSTR("None")}}; } // not used. just for reference for derived classes
@@ -167,7 +171,7 @@ class Bus {
               type == TYPE_SK6812_RGBW || type == TYPE_TM1814 || type == TYPE_UCS8904 ||
               type == TYPE_FW1906 || type == TYPE_WS2805 || type == TYPE_SM16825 ||        // digital types with white channel
               (type > TYPE_ONOFF && type <= TYPE_ANALOG_5CH && type != TYPE_ANALOG_3CH) || // analog types with white channel
-              type == TYPE_NET_DDP_RGBW || type == TYPE_NET_ARTNET_RGBW;                   // network types with white channel
+              type == TYPE_NET_DDP_RGBW || type == TYPE_NET_ARTNET_RGBW || type == TYPE_NET_E131_RGBW; // network types with white channel
     }
     static constexpr bool hasCCT(uint8_t type) {
       return  type == TYPE_WS2812_2CH_X3 || type == TYPE_WS2812_WWA ||
@@ -211,6 +215,7 @@ class Bus {
       bool _hasRgb;//       : 1;
       bool _hasWhite;//     : 1;
       bool _hasCCT;//       : 1;
+      bool _dirty;//        : 1; // output differs from what was last sent; cleared by show() of busses that track changes
     //} __attribute__ ((packed));
     uint8_t  _autoWhiteMode;
     // global Auto White Calculation override
@@ -240,6 +245,7 @@ class BusDigital : public Bus {
     void setBrightness(uint8_t b) override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColors(unsigned pix, const uint32_t *c, unsigned len) override;
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -263,11 +269,11 @@ class BusDigital : public Bus {
     uint16_t _frequencykHz;
     uint8_t  _milliAmpsPerLed;
     uint16_t _milliAmpsMax;
+    uint16_t _milliAmpsTotal; // is recalculated on each show()
+    uint32_t _colorSum;       // ABL: sum of pixelPower() of all pixels in _data, maintained by setPixelColor()
     uint8_t *_data;
     void    *_busPtr;
 
-    static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
-
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
       if (restoreBri < 255) {
         uint8_t* chan = (uint8_t*) &c;
@@ -279,7 +285,8 @@ class BusDigital : public Bus {
       return c;
     }
 
-    uint8_t  estimateCurrentAndLimitBri() const;
+    inline uint32_t pixelPower(uint32_t c) const; // ABL power units of a pixel
+    uint8_t  estimateCurrentAndLimitBri();
 };
 
 
@@ -338,8 +345,10 @@ class BusNetwork : public Bus {
 
     bool canShow() const override  { return !_broadcastLock; } // this should be a return value from UDP routine if it is still sending data out
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColors(unsigned pix, const uint32_t *c, unsigned len) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     unsigned getPins(uint8_t* pinArray = nullptr) const override;
+    uint16_t getUniverse() const override { return _UDPtype == 1 ? _universe : 0; } // E1.31 start universe
     unsigned getBusSize() const override  { return sizeof(BusNetwork) + (isOk() ? _len * _UDPchannels : 0); }
     void show() override;
     void cleanup();
@@ -348,6 +357,7 @@ class BusNetwork : public Bus {
 
   private:
     IPAddress _client;
+    uint16_t  _universe;
     uint8_t   _UDPtype;
     uint8_t   _UDPchannels;
     bool      _broadcastLock;
@@ -370,8 +380,9 @@ struct BusConfig {
   bool doubleBuffer;
   uint8_t milliAmpsPerLed;
   uint16_t milliAmpsMax;
+  uint16_t universe;  // first universe of E1.31 network busses
 
-  BusConfig(uint8_t busType, uint8_t* ppins, uint16_t pstart, uint16_t len = 1, uint8_t pcolorOrder = COL_ORDER_GRB, bool rev = false, uint8_t skip = 0, byte aw=RGBW_MODE_MANUAL_ONLY, uint16_t clock_kHz=0U, bool dblBfr=false, uint8_t maPerLed=LED_MILLIAMPS_DEFAULT, uint16_t maMax=ABL_MILLIAMPS_DEFAULT)
+  BusConfig(uint8_t busType, uint8_t* ppins, uint16_t pstart, uint16_t len = 1, uint8_t pcolorOrder = COL_ORDER_GRB, bool rev = false, uint8_t skip = 0, byte aw=RGBW_MODE_MANUAL_ONLY, uint16_t clock_kHz=0U, bool dblBfr=false, uint8_t maPerLed=LED_MILLIAMPS_DEFAULT, uint16_t maMax=ABL_MILLIAMPS_DEFAULT, uint16_t uni=1)
   : count(std::max(len,(uint16_t)1))
   , start(pstart)
   , colorOrder(pcolorOrder)
@@ -382,6 +393,7 @@ struct BusConfig {
   , doubleBuffer(dblBfr)
   , milliAmpsPerLed(maPerLed)
   , milliAmpsMax(maMax)
+  , universe(uni)
   {
     refreshReq = (bool) GET_BIT(busType,7);
     type = busType & 0x7F;  // bit 7 may be/is hacked to include refresh info (1=refresh in off state, 0=no refresh)
@@ -425,12 +437,20 @@ struct BusConfig {
   #endif
 #endif
 
+// entries of BusManager::_busMap
+#define BUSMAP_MULTI 254 // pixel is covered by more than one (overlapping) bus
+#define BUSMAP_NONE  255 // pixel is not covered by any bus
+
 namespace BusManager {
 
   extern std::vector<std::unique_ptr<Bus>> busses;
   //extern std::vector<Bus*> busses;
   extern uint16_t _gMilliAmpsUsed;
   extern uint16_t _gMilliAmpsMax;
+  extern uint16_t _keepAliveMs;         // unchanged busses are re-sent at this interval (0 = every show())
+  extern unsigned long _lastKeepAlive;
+  extern std::vector<uint8_t> _busMap;  // logical pixel -> index into busses (or BUSMAP_*), rebuilt by add() and removeAll()
+  extern bool _busMapOverlap;           // at least one pixel is covered by more than one bus
 
   #ifdef ESP32_DATA_IDLE_HIGH
   void    esp32RMTInvertIdle() ;
@@ -446,6 +466,8 @@ namespace BusManager {
   //inline uint16_t ablMilliampsMax()             { unsigned sum = 0; for (auto &bus : busses) sum += bus->getMaxCurrent(); return sum; }
   inline uint16_t ablMilliampsMax()             { return _gMilliAmpsMax; }  // used for compatibility reasons (and enabling virtual global ABL)
   inline void     setMilliampsMax(uint16_t max) { _gMilliAmpsMax = max;}
+  inline uint16_t getKeepAlive()                { return _keepAliveMs; }
+  inline void     setKeepAlive(uint16_t ms)     { _keepAliveMs = ms; }
 
   void useParallelOutput(); // workaround for inaccessible PolyBus
   bool hasParallelOutput(); // workaround for inaccessible PolyBus
@@ -457,7 +479,10 @@ namespace BusManager {
   void on();
   void off();
 
+  void updateBusMap();
+
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+  [[gnu::hot]] void     setPixelColors(unsigned pix, const uint32_t *c, unsigned len); // bulk write of consecutive pixels (may span busses)
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
   void        show();
   bool        canAllShow();
@@ -136,7 +136,13 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   uint8_t cctBlending = hw_led[F("cb")] | Bus::getCCTBlend();
   Bus::setCCTBlend(cctBlending);
   strip.setTargetFps(hw_led["fps"]); //NOP if 0, default 42 FPS
+  BusManager::setKeepAlive(hw_led[F("ka")] | BusManager::getKeepAlive());
+  CJSON(e131OutPriority, hw_led[F("e131prio")]);
+  if (e131OutPriority > 200) e131OutPriority = 200;
+  CJSON(e131OutSyncUniverse, hw_led[F("e131sync")]);
+  if (e131OutSyncUniverse > 63999) e131OutSyncUniverse = 0;
   CJSON(useGlobalLedBuffer, hw_led[F("ld")]);
+  CJSON(useSegmentBuffers, hw_led[F("sb")]);
   #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
   CJSON(useParallelI2S, hw_led[F("prl")]);
   #endif
@@ -208,6 +214,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       uint8_t AWmode = elm[F("rgbwm")] | RGBW_MODE_MANUAL_ONLY;
       uint8_t maPerLed = elm[F("ledma")] | LED_MILLIAMPS_DEFAULT;
       uint16_t maMax = elm[F("maxpwr")] | (ablMilliampsMax * length) / total; // rough (incorrect?) per strip ABL calculation when no config exists
+      uint16_t universe = elm[F("uni")] | 1; // E1.31 network bus start universe
+      if (universe == 0 || universe > 63999) universe = 1;
       // To disable brightness limiter we either set output max current to 0 or single LED current to 0 (we choose output max current)
       if (Bus::isPWM(ledType) || Bus::isOnOff(ledType) || Bus::isVirtual(ledType)) { // analog and virtual
         maPerLed = 0;
@@ -216,7 +224,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       ledType |= refresh << 7; // hack bit 7 to indicate strip requires off refresh
 
       //busConfigs.push_back(std::move(BusConfig(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, useGlobalLedBuffer, maPerLed, maMax)));
-      busConfigs.emplace_back(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, useGlobalLedBuffer, maPerLed, maMax);
+      busConfigs.emplace_back(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, useGlobalLedBuffer, maPerLed, maMax, universe);
       doInitBusses = true;  // finalization done in beginStrip()
       if (!Bus::isVirtual(ledType)) s++; // have as many virtual buses as you want
     }
@@ -480,6 +488,10 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(nodeListEnabled, if_nodes[F("list")]);
   CJSON(nodeBroadcastEnabled, if_nodes[F("bcast")]);
 
+  JsonObject if_clock = interfaces["clock"];
+  CJSON(clockSync, if_clock["en"]);
+  CJSON(clockSyncPriority, if_clock[F("prio")]);
+
   JsonObject if_live = interfaces["live"];
   CJSON(receiveDirect, if_live["en"]);  // UDP/Hyperion realtime
   CJSON(useMainSegmentOnly, if_live[F("mso")]);
@@ -491,6 +503,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject if_live_dmx = if_live["dmx"];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
   CJSON(e131SkipOutOfSequence, if_live_dmx[F("seqskip")]);
+  CJSON(e131FrameTimeout, if_live_dmx[F("frameto")]);
+  if (e131FrameTimeout > 1000) e131FrameTimeout = 1000;
   CJSON(DMXAddress, if_live_dmx[F("addr")]);
   if (!DMXAddress || DMXAddress > 510) DMXAddress = 1;
   CJSON(DMXSegmentSpacing, if_live_dmx[F("dss")]);
@@ -715,9 +729,7 @@ void serializeConfigToFS() {
 
   serializeConfig(root);
 
-  File f = WLED_FS.open(FPSTR(s_cfg_json), "w");
-  if (f) serializeJson(root, f);
-  f.close();
+  writeObjectToFile(s_cfg_json, nullptr, pDoc); // journaled, folded into /cfg.json later
   releaseJSONBufferLock();
 
   configNeedsWrite = false;
@@ -825,8 +837,12 @@ void serializeConfig(JsonObject root) {
   hw_led[F("ic")] = cctICused;
   hw_led[F("cb")] = Bus::getCCTBlend();
   hw_led["fps"] = strip.getTargetFps();
+  hw_led[F("ka")] = BusManager::getKeepAlive();
+  hw_led[F("e131prio")] = e131OutPriority;
+  hw_led[F("e131sync")] = e131OutSyncUniverse;
   hw_led[F("rgbwm")] = Bus::getGlobalAWMode(); // global auto white mode override
   hw_led[F("ld")] = useGlobalLedBuffer;
+  hw_led[F("sb")] = useSegmentBuffers;
   #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
   hw_led[F("prl")] = BusManager::hasParallelOutput();
   #endif
@@ -883,6 +899,7 @@ void serializeConfig(JsonObject root) {
     ins[F("freq")]   = bus->getFrequency();
     ins[F("maxpwr")] = bus->getMaxCurrent();
     ins[F("ledma")]  = bus->getLEDCurrent();
+    if (bus->getUniverse()) ins[F("uni")] = bus->getUniverse();
   }
 
   JsonArray hw_com = hw.createNestedArray(F("com"));
@@ -1001,6 +1018,10 @@ void serializeConfig(JsonObject root) {
   if_nodes[F("list")] = nodeListEnabled;
   if_nodes[F("bcast")] = nodeBroadcastEnabled;
 
+  JsonObject if_clock = interfaces.createNestedObject("clock");
+  if_clock["en"] = clockSync;
+  if_clock[F("prio")] = clockSyncPriority;
+
   JsonObject if_live = interfaces.createNestedObject("live");
   if_live["en"] = receiveDirect; // UDP/Hyperion realtime
   if_live[F("mso")] = useMainSegmentOnly;
@@ -1011,6 +1032,7 @@ void serializeConfig(JsonObject root) {
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
+  if_live_dmx[F("frameto")] = e131FrameTimeout;
   if_live_dmx[F("e131prio")] = e131Priority;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
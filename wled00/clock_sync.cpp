@@ -0,0 +1,210 @@
+#include "wled.h"
+
+/*
+ * Network clock synchronisation between WLED nodes
+ *
+ * Nodes with clock sync enabled elect a master (lowest priority value, then lowest IP)
+ * and measure their offset to its clock NTP style, with a round trip of timestamps.
+ * The engine runs on the resulting network clock (WS2812FX::now) and renders on a frame
+ * grid derived from it, so nodes showing the same effect with the same settings and
+ * timebase (sent along with every notification) compute identical frames in lockstep.
+ *
+ * Packets use the supplemental notifier port (udpPort2), all times are in us, big endian:
+ *   ANNOUNCE  [254, 0, priority, 0]                            broadcast every CLOCK_ANNOUNCE_MS
+ *   REQUEST   [254, 1, seq, 0, t1(8)]                          to the master
+ *   RESPONSE  [254, 2, seq, 0, t1(8), t2(8), t3(8)]            back to the requester
+ * t1: request sent (requester's local clock), t2: request received and t3: response sent
+ * (responder's network clock), t4: response received (local clock)
+ *   offset = ((t2 - t1) + (t3 - t4)) / 2       delay = (t4 - t1) - (t3 - t2)
+ * Packets are polled from the main loop, so a sample is only as good as the loop latency
+ * on both ends; the sample with the smallest round trip of the last CLOCK_SAMPLES is used.
+ */
+
+#define CLOCK_ANNOUNCE       0
+#define CLOCK_REQUEST        1
+#define CLOCK_RESPONSE       2
+
+#define CLOCK_ANNOUNCE_MS    2000   // master election broadcast interval
+#define CLOCK_MASTER_TIMEOUT 7000   // master is gone after missing 3 announcements
+#define CLOCK_LISTEN_MS      3000   // a node only takes over as master after hearing no better one for this long
+#define CLOCK_POLL_FAST_MS   250    // request interval while acquiring
+#define CLOCK_POLL_MS        1000   // request interval when locked
+#define CLOCK_FAST_POLLS     8      // requests at the fast interval after a master change
+#define CLOCK_SAMPLES        8      // samples the best (lowest delay) one is chosen from
+#define CLOCK_MAX_DELAY_US   100000 // samples with a longer round trip are discarded
+#define CLOCK_STEP_US        20000  // larger errors are corrected at once, smaller ones slewed
+
+typedef struct ClockSample {
+  int64_t  offset;
+  uint32_t delay;
+} clock_sample_t;
+
+static int64_t        clockOffsetUs = 0;     // network clock - local clock
+static clock_sample_t clockSamples[CLOCK_SAMPLES];
+static uint8_t        clockSampleCount = 0, clockSampleIdx = 0;
+static uint8_t        clockMasterPrio = 255;
+static uint8_t        clockSeq = 0;          // sequence number of the outstanding request
+static int64_t        clockRequestT1 = 0;    // send time of the outstanding request, 0 = none
+static uint8_t        clockPolls = 0;        // requests sent to the current master
+static unsigned long  clockLastAnnounce = 0, clockLastMasterSeen = 0, clockLastPoll = 0;
+static unsigned long  clockMasterSince = 0;  // master change
+static bool           clockWasEnabled = false;
+static clock_sync_status_t clockStatus;
+
+// 64 bit local clock, does not roll over
+static int64_t localMicros() {
+#ifdef ESP8266
+  return micros64();
+#else
+  return esp_timer_get_time();
+#endif
+}
+
+int64_t networkMicros() {
+  return localMicros() + clockOffsetUs;
+}
+
+const clock_sync_status_t& getClockSyncStatus() {
+  clockStatus.offset = clockOffsetUs;
+  return clockStatus;
+}
+
+static void putTime(uint8_t *p, int64_t t) {
+  for (int i = 7; i >= 0; i--) { p[i] = t & 0xFF; t >>= 8; }
+}
+
+static int64_t getTime(const uint8_t *p) {
+  uint64_t t = 0;
+  for (size_t i = 0; i < 8; i++) t = (t << 8) | p[i];
+  return (int64_t)t;
+}
+
+// lower priority value wins, then lower IP
+static bool isBetterMaster(uint8_t prio, IPAddress ip, uint8_t otherPrio, IPAddress otherIp) {
+  if (prio != otherPrio) return prio < otherPrio;
+  for (size_t i = 0; i < 4; i++) if (ip[i] != otherIp[i]) return ip[i] < otherIp[i];
+  return false;
+}
+
+static void sendClockPacket(IPAddress to, const uint8_t *data, size_t len) {
+  notifier2Udp.beginPacket(to, udpPort2);
+  notifier2Udp.write(data, len);
+  notifier2Udp.endPacket();
+}
+
+static void setMaster(IPAddress master, uint8_t prio) {
+  DEBUG_PRINTF_P(PSTR("Clock sync master: %u.%u.%u.%u\n"), master[0], master[1], master[2], master[3]);
+  clockStatus.master = master;
+  clockStatus.samples = 0;
+  clockMasterPrio = prio;
+  clockLastMasterSeen = clockMasterSince = millis();
+  clockSampleCount = clockSampleIdx = 0;
+  clockRequestT1 = 0;
+  clockPolls = 0;
+  clockLastPoll = 0;
+}
+
+// hand the offset to the engine, rounded to the millis() resolution
+static void applyClock() {
+  bool isMaster = clockStatus.master == IPAddress(0,0,0,0);
+  clockStatus.locked = clockSync && (isMaster ? millis() - clockMasterSince > CLOCK_LISTEN_MS : clockStatus.samples > 0);
+  strip.clockOffset = (clockOffsetUs + (clockOffsetUs < 0 ? -500 : 500)) / 1000;
+  strip.clockLocked = clockStatus.locked;
+}
+
+static void addSample(int64_t offset, uint32_t delay) {
+  clockSamples[clockSampleIdx] = {offset, delay};
+  clockSampleIdx = (clockSampleIdx + 1) % CLOCK_SAMPLES;
+  if (clockSampleCount < CLOCK_SAMPLES) clockSampleCount++;
+
+  const clock_sample_t *best = &clockSamples[0];
+  for (size_t i = 1; i < clockSampleCount; i++) if (clockSamples[i].delay < best->delay) best = &clockSamples[i];
+
+  int64_t error = best->offset - clockOffsetUs;
+  if (clockStatus.samples == 0 || error > CLOCK_STEP_US || error < -CLOCK_STEP_US) clockOffsetUs = best->offset; // step
+  else                                                                               clockOffsetUs += error / 4;     // slew
+  clockStatus.delay = best->delay;
+  clockStatus.error = error;
+  clockStatus.samples++;
+  applyClock();
+}
+
+void handleClockSyncPacket(const uint8_t *data, size_t len, IPAddress from) {
+  if (!clockSync || len < 4 || data[0] != CLOCK_SYNC_TOKEN || from == Network.localIP()) return;
+
+  switch (data[1]) {
+    case CLOCK_ANNOUNCE: {
+      IPAddress master = clockStatus.master;
+      if (master == from) {
+        clockLastMasterSeen = millis();
+        clockMasterPrio = data[2];
+        if (isBetterMaster(clockSyncPriority, Network.localIP(), clockMasterPrio, master)) setMaster(IPAddress(0,0,0,0), clockSyncPriority); // master lost priority
+      } else {
+        bool isMaster = master == IPAddress(0,0,0,0);
+        if (isBetterMaster(data[2], from, isMaster ? clockSyncPriority : clockMasterPrio, isMaster ? Network.localIP() : master)) setMaster(from, data[2]);
+      }
+      applyClock();
+      break;
+    }
+    case CLOCK_REQUEST: {
+      if (len < 12) return;
+      uint8_t out[28];
+      memcpy(out, data, 12);                   // token, seq and t1 are returned as received
+      out[1] = CLOCK_RESPONSE;
+      putTime(out + 12, networkMicros());      // t2
+      putTime(out + 20, networkMicros());      // t3
+      sendClockPacket(from, out, sizeof(out));
+      break;
+    }
+    case CLOCK_RESPONSE: {
+      int64_t t4 = localMicros();
+      if (len < 28 || from != clockStatus.master || data[2] != clockSeq || !clockRequestT1) return;
+      int64_t t1 = getTime(data + 4), t2 = getTime(data + 12), t3 = getTime(data + 20);
+      if (t1 != clockRequestT1) return;        // stale or foreign response
+      clockRequestT1 = 0;
+      int64_t delay = (t4 - t1) - (t3 - t2);
+      if (delay < 0) delay = 0;
+      if (delay > CLOCK_MAX_DELAY_US) return;
+      addSample(((t2 - t1) + (t3 - t4)) / 2, delay);
+      break;
+    }
+  }
+}
+
+void handleClockSync() {
+  if (clockSync != clockWasEnabled) { // (re)start from scratch, the engine runs on the local clock while disabled
+    clockWasEnabled = clockSync;
+    clockOffsetUs = 0;
+    setMaster(IPAddress(0,0,0,0), clockSyncPriority);
+    clockLastAnnounce = 0;
+    applyClock();
+  }
+  if (!clockSync || !udp2Connected || !Network.isConnected()) return;
+
+  unsigned long now = millis();
+  if (clockLastAnnounce == 0 || now - clockLastAnnounce > CLOCK_ANNOUNCE_MS) {
+    clockLastAnnounce = now;
+    uint8_t out[4] = {CLOCK_SYNC_TOKEN, CLOCK_ANNOUNCE, clockSyncPriority, 0};
+    sendClockPacket(IPAddress(255,255,255,255), out, sizeof(out));
+  }
+
+  IPAddress master = clockStatus.master;
+  if (master == IPAddress(0,0,0,0)) { // this node is the master
+    if (!clockStatus.locked) applyClock();
+    return;
+  }
+  if (now - clockLastMasterSeen > CLOCK_MASTER_TIMEOUT) { // keep the network clock running and wait for the next best node
+    setMaster(IPAddress(0,0,0,0), clockSyncPriority);
+    applyClock();
+    return;
+  }
+
+  if (clockLastPoll == 0 || now - clockLastPoll > (clockPolls < CLOCK_FAST_POLLS ? CLOCK_POLL_FAST_MS : CLOCK_POLL_MS)) {
+    clockLastPoll = now;
+    if (clockPolls < 255) clockPolls++;
+    uint8_t out[12] = {CLOCK_SYNC_TOKEN, CLOCK_REQUEST, ++clockSeq, 0};
+    clockRequestT1 = localMicros();
+    putTime(out + 4, clockRequestT1);
+    sendClockPacket(master, out, sizeof(out));
+  }
+}
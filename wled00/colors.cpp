@@ -20,6 +20,32 @@ uint32_t color_blend(uint32_t color1, uint32_t color2, uint8_t blend) {
   return rb3 | wg3;
 }
 
+/*
+ * layer blend of two colors (segment blend modes, see SEG_BLEND_* in FX.h), per channel:
+ * under is the pixel already in the strip buffer, over the pixel of the segment on top
+ */
+uint32_t color_blend_mode(uint32_t under, uint32_t over, uint8_t mode) {
+  if (mode == SEG_BLEND_NORMAL || mode >= SEG_BLEND_COUNT) return over;
+  uint32_t out = 0;
+  for (unsigned shift = 0; shift < 32; shift += 8) {
+    const int a = (under >> shift) & 0xFF;
+    const int b = (over  >> shift) & 0xFF;
+    int c;
+    switch (mode) {
+      case SEG_BLEND_ADD:        c = std::min(a + b, 255);                   break;
+      case SEG_BLEND_SUBTRACT:   c = std::max(a - b, 0);                     break;
+      case SEG_BLEND_MULTIPLY:   c = (a * b + 255) >> 8;                     break;
+      case SEG_BLEND_LIGHTEN:    c = std::max(a, b);                         break;
+      case SEG_BLEND_DARKEN:     c = std::min(a, b);                         break;
+      case SEG_BLEND_SCREEN:     c = 255 - (((255 - a) * (255 - b) + 255) >> 8); break;
+      case SEG_BLEND_AVERAGE:    c = (a + b) >> 1;                           break;
+      default:                   c = abs(a - b);                             break; // SEG_BLEND_DIFFERENCE
+    }
+    out |= uint32_t(c) << shift;
+  }
+  return out;
+}
+
 /*
  * color add function that preserves ratio
  * original idea: https://github.com/wled-dev/WLED/pull/2465 by https://github.com/Proto-molecule
@@ -86,6 +112,64 @@ uint32_t color_fade(uint32_t c1, uint8_t amount, bool video)
   return scaledcolor;
 }
 
+/*
+ * span versions of the above for whole-segment operations, working in place on a run of len pixels
+ * that are stride pixels apart (1 for a row, segment width for a column of a 2D segment buffer)
+ * results are identical to calling the single color functions for each pixel
+ */
+void color_fade_span(uint32_t *px, size_t len, size_t stride, uint8_t amount)
+{
+  if (amount == 255) return;
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t scale = amount + 1;
+  for (size_t i = 0; i < len; i++, px += stride) {
+    uint32_t c = *px;
+    *px = ((((c & TWO_CHANNEL_MASK) * scale) >> 8) & TWO_CHANNEL_MASK) | ((((c >> 8) & TWO_CHANNEL_MASK) * scale) & ~TWO_CHANNEL_MASK);
+  }
+}
+
+// blend all pixels toward color c2; terms of c2 are only calculated once
+void color_blend_span(uint32_t *px, size_t len, size_t stride, uint32_t c2, uint8_t blend)
+{
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t rb2 =  c2       & TWO_CHANNEL_MASK;
+  const uint32_t wg2 = (c2 >> 8) & TWO_CHANNEL_MASK;
+  const uint32_t rbK = rb2 + rb2 * blend; // ((rb1 << 8) | rb2) == (rb1 << 8) + rb2 as bits do not overlap (see color_blend())
+  const uint32_t wgK = wg2 + wg2 * blend;
+  const uint32_t keep = 256 - blend;
+  for (size_t i = 0; i < len; i++, px += stride) {
+    uint32_t c = *px;
+    *px = (((( c       & TWO_CHANNEL_MASK) * keep + rbK) >> 8) & TWO_CHANNEL_MASK)
+        |  ((((c >> 8) & TWO_CHANNEL_MASK) * keep + wgK)       & ~TWO_CHANNEL_MASK);
+  }
+}
+
+// FastLED style blur of one row or column (see Segment::blur())
+void color_blur_span(uint32_t *px, size_t len, size_t stride, uint8_t keep, uint8_t seep)
+{
+  if (len == 0) return;
+  uint32_t carryover = BLACK;
+  uint32_t lastnew = BLACK;
+  uint32_t last = BLACK;
+  uint32_t curnew = BLACK;
+  uint32_t *prevPx = px;
+  for (size_t i = 0; i < len; i++, px += stride) {
+    uint32_t cur = *px;
+    uint32_t part = color_fade(cur, seep);
+    curnew = color_fade(cur, keep);
+    if (i > 0) {
+      if (carryover) curnew = color_add(curnew, carryover);
+      uint32_t prev = color_add(lastnew, part);
+      if (last != prev) *prevPx = prev; // unchanged pixels keep their value, this includes the first pixel's curnew
+      prevPx = px;
+    } else *px = curnew; // first pixel
+    lastnew = curnew;
+    last = cur;
+    carryover = part;
+  }
+  *prevPx = curnew; // last pixel
+}
+
 // 1:1 replacement of fastled function optimized for ESP, slightly faster, more accurate and uses less flash (~ -200bytes)
 uint32_t ColorFromPaletteWLED(const CRGBPalette16& pal, unsigned index, uint8_t brightness, TBlendType blendType)
 {
@@ -330,10 +330,11 @@
 //Network types (master broadcast) (80-95)
 #define TYPE_VIRTUAL_MIN         80
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
-#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGBW     89            //network ArtNet RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGBW       90            //network E131 RGBW bus (master broadcast bus)
 #define TYPE_VIRTUAL_MAX         95
 
 /*
@@ -533,6 +534,11 @@
   #endif
 #endif
 
+// unchanged outputs are only re-sent at this interval (ms, 0 = on every frame)
+#ifndef BUS_KEEPALIVE_DEFAULT
+  #define BUS_KEEPALIVE_DEFAULT 1000
+#endif
+
 #ifndef LED_MILLIAMPS_DEFAULT
   #define LED_MILLIAMPS_DEFAULT 55    // common WS2812B
 #else
@@ -569,6 +575,53 @@
   #endif
 #endif
 
+// Additional JSON documents for read-only API responses (allocated on demand, see requestJSONDocument())
+// and the free heap that has to remain after allocating one
+#ifndef WLED_JSON_POOL_SIZE
+  #ifdef ESP8266
+    #define WLED_JSON_POOL_SIZE 1
+  #else
+    #define WLED_JSON_POOL_SIZE 3
+  #endif
+#endif
+#ifdef ESP8266
+  #define JSON_POOL_HEAP_RESERVE 16384
+#else
+  #define JSON_POOL_HEAP_RESERVE 32768
+#endif
+
+// Presets kept MessagePack encoded in RAM (PSRAM if available) for fast switching, see presets.cpp
+#ifndef WLED_PRESET_CACHE_ENTRIES
+  #ifdef ESP8266
+    #define WLED_PRESET_CACHE_ENTRIES 4
+  #else
+    #define WLED_PRESET_CACHE_ENTRIES 16
+  #endif
+#endif
+#ifndef WLED_PRESET_CACHE_BYTES
+  #ifdef ESP8266
+    #define WLED_PRESET_CACHE_BYTES 2048
+  #else
+    #define WLED_PRESET_CACHE_BYTES 16384
+  #endif
+#endif
+
+// Ledmaps kept encoded (see FX_fcn.cpp) for fast switching
+#ifndef WLED_LEDMAP_CACHE_ENTRIES
+  #ifdef ESP8266
+    #define WLED_LEDMAP_CACHE_ENTRIES 2
+  #else
+    #define WLED_LEDMAP_CACHE_ENTRIES 4
+  #endif
+#endif
+#ifndef WLED_LEDMAP_CACHE_BYTES
+  #ifdef ESP8266
+    #define WLED_LEDMAP_CACHE_BYTES 1024
+  #else
+    #define WLED_LEDMAP_CACHE_BYTES 8192
+  #endif
+#endif
+
 //#define MIN_HEAP_SIZE
 #define MIN_HEAP_SIZE 2048
 
@@ -3,11 +3,83 @@
 #define MAX_3_CH_LEDS_PER_UNIVERSE 170
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
 #define MAX_CHANNELS_PER_UNIVERSE 512
+#define E131_SYNC_TIMEOUT 2500 // ms without sync packets after which a source is treated as unsynchronized
 
 /*
  * E1.31 handler
  */
 
+// Frame assembly for DMX_MODE_MULTIPLE_* over network (E1.31/Art-Net):
+// a frame is only shown once all universes of the source have been written,
+// or on a sync packet if the source synchronizes its universes, instead of after every universe.
+static uint32_t frameUniverses = 0;       // universes (bit n = e131Universe + n) written since the last shown frame
+static uint32_t sourceUniverses = 0;      // universes the source sends per frame, learned from complete frames
+static unsigned long frameStart = 0;      // arrival of the first universe of the current frame
+static uint16_t frameSyncUniverse = 0;    // E1.31 sync universe announced by the last data packet (0 = none)
+static uint16_t joinedSyncUniverse = 0;   // multicast group joined for frameSyncUniverse
+static unsigned long lastSync = 0;        // last E1.31 sync or ArtSync packet from the realtime source
+static bool packetSynced = false;         // the universe being handled waits for a sync packet
+
+// number of universes DMX_MODE_MULTIPLE_* needs for the whole strip
+static unsigned multiUniverseCount() {
+  const bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
+  const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+  const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
+  const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
+  const unsigned totalLen = strip.getLengthTotal();
+  unsigned count = 1;
+
+  if (totalLen > ledsInFirstUniverse) {
+    const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+    count += (totalLen - ledsInFirstUniverse + ledsPerUniverse - 1) / ledsPerUniverse;
+  }
+  return min(count, (unsigned)E131_MAX_UNIVERSE_COUNT);
+}
+
+static void resetFrame() {
+  frameUniverses = 0;
+  sourceUniverses = 0;
+  lastSync = 0;
+}
+
+// show the assembled frame
+static void presentFrame() {
+  if (!frameUniverses) return;
+  frameUniverses = 0;
+  e131NewData = true;
+  realtimeLatencyReady();
+}
+
+// a universe of a DMX_MODE_MULTIPLE_* frame has been written
+static void assembleFrame(unsigned previousUniverses) {
+  const uint32_t bit = 1UL << previousUniverses;
+  if (e131FrameTimeout == 0) { // legacy: show every universe as it arrives
+    e131NewData = true;
+    realtimeLatencyReady();
+    return;
+  }
+  if (frameUniverses & bit) {
+    // universe repeats: the source started its next frame, so the previous one is as complete as it gets
+    sourceUniverses = frameUniverses;
+    presentFrame();
+  }
+  if (!frameUniverses) frameStart = millis();
+  frameUniverses |= bit;
+
+  if (packetSynced) return; // shown on the sync packet
+  uint32_t expected = sourceUniverses ? sourceUniverses : (1UL << multiUniverseCount()) - 1;
+  if ((frameUniverses & expected) == expected) {
+    sourceUniverses = frameUniverses;
+    presentFrame();
+  }
+}
+
+// shows a frame that has been waiting too long for a lost universe or sync packet
+void handleE131FrameTimeout() {
+  if (frameUniverses && millis() - frameStart > e131FrameTimeout) presentFrame();
+}
+
 //DDP protocol support, called by handleE131Packet
 //handles RGB data only
 void handleDDPPacket(e131_packet_t* p) {
@@ -35,20 +107,20 @@ void handleDDPPacket(e131_packet_t* p) {
   unsigned c = 0;
   if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
 
+  realtimeLatencyReceived(micros());
   if (realtimeMode != REALTIME_MODE_DDP) ddpSeenPush = false; // just starting, no push yet
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
   if (!realtimeOverride || (realtimeMode && useMainSegmentOnly)) {
     if (useMainSegmentOnly) strip.getMainSegment().beginDraw();
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-    }
+    if (stop > start) setRealtimePixels(start, data + c, stop - start, ddpChannelsPerLed);
   }
 
   bool push = p->flags & DDP_PUSH_FLAG;
   ddpSeenPush |= push;
   if (!ddpSeenPush || push) { // if we've never seen a push, or this is one, render display
     e131NewData = true;
+    realtimeLatencyReady();
     int sn = p->sequenceNum & 0xF;
     if (sn) e131LastSequenceNumber[0] = sn;
   }
@@ -67,12 +139,25 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      // ArtSync is broadcast, only the source we are receiving from may trigger output (Art-Net 4)
+      if (realtimeMode != REALTIME_MODE_ARTNET || clientIP != realtimeIP) return;
+      lastSync = millis();
+      presentFrame();
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (htonl(p->root_vector) == ESPAsyncE131::VECTOR_ROOT_EXTENDED) { // synchronization packet
+      if (realtimeMode != REALTIME_MODE_E131 || !frameSyncUniverse || htons(p->sync_universe) != frameSyncUniverse) return;
+      lastSync = millis();
+      presentFrame();
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
@@ -81,6 +166,11 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     uni = htons(p->universe);
     e131_data = p->property_values;
     seq = p->sequence_number;
+    frameSyncUniverse = htons(p->sync_address);
+    if (e131Multicast && frameSyncUniverse && frameSyncUniverse != joinedSyncUniverse) {
+      e131.joinUniverse(frameSyncUniverse);
+      joinedSyncUniverse = frameSyncUniverse;
+    }
     if (e131Priority != 0) {
       if (p->priority < e131Priority ) return;
       // track highest priority & skip all lower priorities
@@ -116,8 +206,13 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
   // update status info
   realtimeIP = clientIP;
+  realtimeLatencyReceived(micros());
 
+  if (realtimeMode != mde) resetFrame(); // (re)starting, nothing known about the source
+  // E1.31 sources announce a sync universe in every data packet, Art-Net sources are synchronized once they send ArtSync
+  packetSynced = (mde == REALTIME_MODE_ARTNET || frameSyncUniverse) && lastSync && millis() - lastSync < E131_SYNC_TIMEOUT;
   handleDMXData(uni, dmxChannels, e131_data, mde, previousUniverses);
+  packetSynced = false;
 }
 
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses) {
@@ -317,16 +412,11 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
         }
 
         if (useMainSegmentOnly) strip.getMainSegment().beginDraw();
-        if (!is4Chan) {
-          for (unsigned i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], 0);
-            dmxOffset+=3;
-          }
-        } else {
-          for (unsigned i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], e131_data[dmxOffset+3]);
-            dmxOffset+=4;
-          }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, e131_data + dmxOffset, ledsTotal - previousLeds, dmxChannelsPerLed);
+        // wired DMX input has no frame structure beyond its single universe
+        if (mde == REALTIME_MODE_E131 || mde == REALTIME_MODE_ARTNET) {
+          assembleFrame(previousUniverses);
+          return;
         }
         break;
       }
@@ -337,6 +427,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
   }
 
   e131NewData = true;
+  realtimeLatencyReady();
 }
 
 void handleArtnetPollReply(IPAddress ipAddress) {
@@ -362,30 +453,8 @@ void handleArtnetPollReply(IPAddress ipAddress) {
     case DMX_MODE_MULTIPLE_DRGB:
     case DMX_MODE_MULTIPLE_RGB:
     case DMX_MODE_MULTIPLE_RGBW:
-      {
-        bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
-        const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
-        const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
-        const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
-        const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
-        const unsigned totalLen = strip.getLengthTotal();
-
-        if (totalLen > ledsInFirstUniverse) {
-          const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
-          const unsigned remainLED = totalLen - ledsInFirstUniverse;
-
-          endUniverse += (remainLED / ledsPerUniverse);
-
-          if ((remainLED % ledsPerUniverse) > 0) {
-            endUniverse++;
-          }
-
-          if ((endUniverse - startUniverse) > E131_MAX_UNIVERSE_COUNT) {
-            endUniverse = startUniverse + E131_MAX_UNIVERSE_COUNT - 1;
-          }
-        }
-        break;
-      }
+      endUniverse += multiUniverseCount() - 1;
+      break;
     default:
       DEBUG_PRINTLN(F("unknown E1.31 DMX mode"));
       return;  // nothing to do
@@ -69,6 +69,21 @@ typedef struct WiFiConfig {
   }
 } wifi_config;
 
+//clock_sync.cpp
+#define CLOCK_SYNC_TOKEN 254 // first byte of clock sync packets on the supplemental notifier port
+typedef struct ClockSyncStatus {
+  IPAddress master;  // node this clock follows, 0.0.0.0 if this node is the master
+  int64_t   offset;  // network clock - local clock (us), exceeds 32 bits for nodes booted more than 35 min apart
+  uint32_t  delay;   // round trip delay of the sample in use (us)
+  int32_t   error;   // offset correction made at the last sample (us)
+  uint32_t  samples; // samples taken from the current master
+  bool      locked;
+} clock_sync_status_t;
+void handleClockSync();
+void handleClockSyncPacket(const uint8_t *data, size_t len, IPAddress from);
+int64_t networkMicros();
+const clock_sync_status_t& getClockSyncStatus();
+
 //colors.cpp
 #define ColorFromPalette ColorFromPaletteWLED // override fastled version
 
@@ -168,7 +183,11 @@ class NeoGammaWLEDMethod {
 [[gnu::hot, gnu::pure]] uint32_t color_blend(uint32_t c1, uint32_t c2 , uint8_t blend);
 inline uint32_t color_blend16(uint32_t c1, uint32_t c2, uint16_t b) { return color_blend(c1, c2, b >> 8); };
 [[gnu::hot, gnu::pure]] uint32_t color_add(uint32_t, uint32_t, bool preserveCR = false);
+[[gnu::hot, gnu::pure]] uint32_t color_blend_mode(uint32_t under, uint32_t over, uint8_t mode);
 [[gnu::hot, gnu::pure]] uint32_t color_fade(uint32_t c1, uint8_t amount, bool video=false);
+[[gnu::hot]] void color_fade_span(uint32_t *px, size_t len, size_t stride, uint8_t amount);
+[[gnu::hot]] void color_blend_span(uint32_t *px, size_t len, size_t stride, uint32_t c2, uint8_t blend);
+[[gnu::hot]] void color_blur_span(uint32_t *px, size_t len, size_t stride, uint8_t keep, uint8_t seep);
 [[gnu::hot, gnu::pure]] uint32_t ColorFromPaletteWLED(const CRGBPalette16 &pal, unsigned index, uint8_t brightness = (uint8_t)255U, TBlendType blendType = LINEARBLEND);
 CRGBPalette16 generateHarmonicRandomPalette(const CRGBPalette16 &basepalette);
 CRGBPalette16 generateRandomPalette();
@@ -198,6 +217,7 @@ void handleDMXInput();
 //e131.cpp
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
+void handleE131FrameTimeout();
 void handleArtnetPollReply(IPAddress ipAddress);
 void prepareArtnetPollReply(ArtPollReply* reply);
 void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t portAddress);
@@ -210,6 +230,12 @@ bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest
 bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter = nullptr);
 void updateFSInfo();
 void closeFile();
+void initPresetIndex();
+void invalidatePresetIndex();
+bool compactPresetsFile();
+void initJournal();
+bool foldJournal(bool force = false);
+void discardJournal(const char* file);
 inline bool writeObjectToFileUsingId(const String &file, uint16_t id, const JsonDocument* content) { return writeObjectToFileUsingId(file.c_str(), id, content); };
 inline bool writeObjectToFile(const String &file, const char* key, const JsonDocument* content) { return writeObjectToFile(file.c_str(), key, content); };
 inline bool readObjectFromFileUsingId(const String &file, uint16_t id, JsonDocument* dest, const JsonDocument* filter = nullptr) { return readObjectFromFileUsingId(file.c_str(), id, dest); };
@@ -268,8 +294,11 @@ bool deserializeState(JsonObject root, byte callMode = CALL_MODE_DIRECT_CHANGE,
 void serializeSegment(const JsonObject& root, const Segment& seg, byte id, bool forPreset = false, bool segmentBounds = true);
 void serializeState(JsonObject root, bool forPreset = false, bool includeBri = true, bool segmentBounds = true, bool selectedSegmentsOnly = false);
 void serializeInfo(JsonObject root);
-void serializeModeNames(JsonArray arr);
-void serializeModeData(JsonArray fxdata);
+void serializeModeNames(JsonArray arr, unsigned start = 0, unsigned count = UINT16_MAX);
+void serializeModeData(JsonArray fxdata, unsigned start = 0, unsigned count = UINT16_MAX);
+#ifdef WLED_ENABLE_RT_LATENCY
+void serializeRealtimeLatency(JsonObject root);
+#endif
 void serveJson(AsyncWebServerRequest* request);
 #ifdef WLED_ENABLE_JSONLIVE
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
@@ -339,6 +368,8 @@ void savePreset(byte index, const char* pname = nullptr, JsonObject saveobj = Js
 inline void saveTemporaryPreset() {savePreset(255);};
 void deletePreset(byte index);
 bool getPresetName(byte index, String& name);
+void prefetchPreset(byte index);
+void invalidatePresetCache(byte index = 0);
 
 //remote.cpp
 void handleWiZdata(uint8_t *incomingData, size_t len);
@@ -351,13 +382,33 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=tru
 
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false, uint16_t startUniverse=1);
+void realtimeBroadcastSync();
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(unsigned i, const uint8_t *data, unsigned count, unsigned channelsPerLed);
 void refreshNodeList();
 void sendSysInfoUDP();
+#ifdef WLED_ENABLE_RT_LATENCY
+#define RT_LATENCY_SAMPLES 64
+// packet-to-photon latency of the last RT_LATENCY_SAMPLES realtime frames (us)
+typedef struct RealtimeLatency {
+  uint32_t ingest[RT_LATENCY_SAMPLES]; // first packet received -> frame complete (parsing, universe assembly)
+  uint32_t wait[RT_LATENCY_SAMPLES];   // frame complete -> show() (main loop cadence, show rate limit)
+  uint32_t bus[RT_LATENCY_SAMPLES];    // show() -> BusManager::show() returned
+  uint32_t count;                      // frames shown
+  uint32_t merged;                     // frames that were still waiting for show() when the next one completed
+} rt_latency_t;
+void realtimeLatencyReceived(unsigned long us);
+void realtimeLatencyReady();
+void realtimeLatencyShown(unsigned long showStart, unsigned long showEnd);
+const rt_latency_t& getRealtimeLatency();
+#else
+inline void realtimeLatencyReceived(unsigned long us) {}
+inline void realtimeLatencyReady() {}
+#endif
 #ifndef WLED_DISABLE_ESPNOW
 void espNowSentCB(uint8_t* address, uint8_t status);
 void espNowReceiveCB(uint8_t* address, uint8_t* data, uint8_t len, signed int rssi, bool broadcast);
@@ -504,6 +555,10 @@ void prepareHostname(char* hostname);
 [[gnu::pure]] bool isAsterisksOnly(const char* str, byte maxLen);
 bool requestJSONBufferLock(uint8_t moduleID=255);
 void releaseJSONBufferLock();
+JsonDocument* requestJSONDocument(uint8_t moduleID=255);
+void unlockJSONDocument(JsonDocument *doc);
+void releaseJSONDocument(JsonDocument *doc);
+void getJSONPoolUsage(uint8_t &allocated, uint8_t &inUse);
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
@@ -32,6 +32,11 @@ static volatile size_t knownLargestSpace = MAX_SPACE;
 
 static File f; // don't export to other cpp files
 
+// result of the last writeObjectToFile(), kept for the preset index
+static size_t writePos = 0;          // position of the written object, 0 if none was written (deleted)
+static size_t writeLen = 0;          // length of the written object
+static size_t writeSizeBefore = 0;   // file size before the write, SIZE_MAX if the file was restructured
+
 //wrapper to find out how long closing takes
 void closeFile() {
   #ifdef WLED_DEBUG_FS
@@ -189,6 +194,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
     char init[10];
     strcpy_P(init, PSTR("{\"0\":{}}"));
     f.print(init);
+    writeSizeBefore = SIZE_MAX;
   }
 
   if (content->isNull()) {
@@ -202,6 +208,8 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
     if (f.position() > 2) f.write(','); //add comma if not first object
     f.print(key);
+    writePos = f.position();
+    writeLen = contentLen;
     serializeJson(*content, f);
     DEBUGFS_PRINTF("Inserted, took %d ms (total %d)", millis() - s1, millis() - s);
     doCloseFile = true;
@@ -242,9 +250,12 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   } else { //file content is not valid JSON object
     f.seek(0, SeekSet);
     f.print('{'); //start JSON
+    writeSizeBefore = SIZE_MAX;
   }
 
   f.print(key);
+  writePos = f.position();
+  writeLen = contentLen;
 
   //Append object
   serializeJson(*content, f);
@@ -255,14 +266,254 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   return true;
 }
 
-bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content)
-{
-  char objKey[10];
-  sprintf(objKey, "\"%d\":", id);
-  return writeObjectToFile(file, objKey, content);
+/*
+ * Preset index
+ * Position and length of every preset object in presets.json, built with a single pass over the
+ * file on first use and kept up to date by writeObjectToFileUsingId(), so presets are read (and
+ * replaced) with a direct seek instead of a search from the start of the file.
+ * Writes only overwrite objects with padding or append, other presets never move. Changes made
+ * behind our back (upload, /edit) are caught by the file size and by checking the key in front of
+ * the indexed position, either causes a rebuild.
+ * Padding left behind by replaced and deleted presets is removed by compactPresetsFile(): the
+ * presets are copied to a new file which then replaces presets.json by renaming it, so power loss
+ * leaves either the old or the new file (initPresetIndex() cleans up after an interrupted run).
+ * The same copy repairs a file cut off by power loss while a preset was being appended.
+ */
+#define PRESET_INDEX_SIZE       251   // IDs 0-250, 255 is the temporary preset in tmp.json
+#define PRESETS_COMPACT_PADDING 4096  // compact once the padding exceeds this and a quarter of the file
+
+typedef struct PresetIndex {
+  uint32_t pos[PRESET_INDEX_SIZE];  // position of the preset's value (behind "<id>":), 0 if there is none
+  uint16_t len[PRESET_INDEX_SIZE];  // length of the value
+  size_t   fileSize;                // size of the indexed file
+  bool     truncated;               // file ends inside the root object
+} preset_index_t;
+
+static preset_index_t *presetIndex = nullptr;
+static bool presetIndexValid = false;
+static bool presetsCompactionDue = false;
+static volatile uint8_t presetsGeneration = 0; // bumped when an upload of presets.json starts and ends (odd while it runs)
+static const char presets_new[] PROGMEM = "/presets.new"; // compacted presets before they replace presets.json
+
+// single pass over the root object of f, records every object value with a preset ID as key
+// (the first one if an ID occurs more than once, as found by bufferedFind())
+static bool buildPresetIndex() {
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Build preset index"));
+    uint32_t s = millis();
+  #endif
+
+  presetIndexValid = false;
+  if (!f) return false;
+  if (!presetIndex) presetIndex = static_cast<preset_index_t*>(malloc(sizeof(preset_index_t)));
+  if (!presetIndex) return false;
+  memset(presetIndex, 0, sizeof(preset_index_t));
+
+  byte buf[FS_BUFSIZE];
+  unsigned depth = 0, keyDigits = 0;
+  bool inString = false, escape = false, isValue = false, rootClosed = false;
+  int key = -1; // root level key (preset ID) being read or whose value is being scanned, -1 if none
+  size_t pos = 0, valueStart = 0;
+
+  f.seek(0);
+  while (!rootClosed) {
+    size_t bufsize = f.read(buf, FS_BUFSIZE);
+    if (!bufsize) break;
+    for (size_t count = 0; count < bufsize && !rootClosed; count++, pos++) {
+      char c = buf[count];
+      if (inString) {
+        if (escape) escape = false;
+        else if (c == '\\') escape = true;
+        else if (c == '"') {
+          inString = false;
+          if (depth == 1 && !isValue && (keyDigits == 0 || key >= PRESET_INDEX_SIZE)) key = -1;
+        } else if (depth == 1 && !isValue && key >= 0) {
+          if (c >= '0' && c <= '9' && keyDigits < 3 && !(keyDigits == 1 && key == 0)) { key = key * 10 + c - '0'; keyDigits++; }
+          else key = -1;
+        }
+        continue;
+      }
+      switch (c) {
+        case '"':
+          inString = true;
+          if (depth == 1 && !isValue) { key = 0; keyDigits = 0; }
+          break;
+        case ':':
+          if (depth == 1) { isValue = true; valueStart = pos + 1; }
+          break;
+        case ',':
+          if (depth == 1) { isValue = false; key = -1; }
+          break;
+        case '{':
+        case '[':
+          depth++;
+          break;
+        case '}':
+        case ']':
+          if (depth == 0) break; // stray bracket
+          depth--;
+          if (depth == 1 && c == '}' && key >= 0) {
+            if (!presetIndex->pos[key] && pos - valueStart < UINT16_MAX) {
+              presetIndex->pos[key] = valueStart;
+              presetIndex->len[key] = pos - valueStart + 1;
+            }
+            key = -1;
+          }
+          if (depth == 0) rootClosed = true;
+          break;
+      }
+    }
+  }
+  presetIndex->truncated = depth > 0;
+  presetIndex->fileSize = f.size();
+  presetIndexValid = true;
+  DEBUGFS_PRINTF("Indexed %u bytes%s, took %d ms\n", presetIndex->fileSize, presetIndex->truncated ? " (truncated)" : "", millis() - s);
+  return true;
 }
 
-bool writeObjectToFile(const char* file, const char* key, const JsonDocument* content)
+// index for the presets file open as f
+static bool ensurePresetIndex() {
+  if (presetIndexValid && presetIndex->fileSize == f.size()) return true;
+  return buildPresetIndex();
+}
+
+// padding (bytes not belonging to a preset) in the indexed file
+static size_t presetPadding() {
+  size_t live = 2; // root braces
+  for (unsigned id = 0; id < PRESET_INDEX_SIZE; id++) {
+    if (presetIndex->pos[id]) live += presetIndex->len[id] + (id < 10 ? 4 : id < 100 ? 5 : 6) + 1; // key and comma
+  }
+  return presetIndex->fileSize > live ? presetIndex->fileSize - live : 0;
+}
+
+// positions f behind the key of preset id, using the index if possible
+static bool findPreset(unsigned id, const char *key) {
+  if (id < PRESET_INDEX_SIZE && ensurePresetIndex()) {
+    size_t pos = presetIndex->pos[id];
+    if (!pos) return false; // not in the file
+    size_t keyLen = strlen(key);
+    char buf[8];
+    if (pos >= keyLen && keyLen <= sizeof(buf) && f.seek(pos - keyLen) && f.read((uint8_t*)buf, keyLen) == keyLen && !memcmp(buf, key, keyLen)) return true;
+    DEBUGFS_PRINTLN(F("Preset index stale."));
+    presetIndexValid = false;
+  }
+  return bufferedFind(key);
+}
+
+static void updatePresetIndex(unsigned id, bool success) {
+  if (!presetIndexValid || id >= PRESET_INDEX_SIZE) return;
+  if (!success || writeSizeBefore != presetIndex->fileSize || writeLen > UINT16_MAX) {
+    presetIndexValid = false;
+    return;
+  }
+  presetIndex->pos[id] = writePos;
+  presetIndex->len[id] = writePos ? writeLen : 0;
+  presetIndex->fileSize = f.size();
+  size_t padding = presetPadding();
+  if (padding > PRESETS_COMPACT_PADDING && padding > presetIndex->fileSize / 4) presetsCompactionDue = true;
+}
+
+// called (without the JSON buffer lock) when an upload replacing presets.json starts and when it ends
+void invalidatePresetIndex() {
+  presetIndexValid = false;
+  presetsGeneration++;
+}
+
+// copies the indexed presets to presets.new and replaces presets.json with it
+static bool rewritePresetsFile() {
+  char fileName[33]; strncpy_P(fileName, getPresetsFileName(), 32); fileName[32] = 0; //use PROGMEM safe copy as FS.open() does not
+  char newName[33];  strncpy_P(newName, presets_new, 32); newName[32] = 0;
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Compact presets"));
+    uint32_t s = millis();
+  #endif
+  const uint8_t generation = presetsGeneration;
+  if (generation & 1) return false; // presets.json is being uploaded
+
+  f = WLED_FS.open(fileName, "r");
+  if (!f) return false;
+  updateFSInfo();
+  if (!ensurePresetIndex() || f.size() + 4096 > (fsBytesTotal - fsBytesUsed)) { // room for a second copy
+    f.close();
+    return false;
+  }
+
+  File out = WLED_FS.open(newName, "w");
+  if (!out) {
+    f.close();
+    return false;
+  }
+  presetIndexValid = false; // positions are updated as presets are copied
+  bool success = out.write('{') == 1;
+  byte buf[FS_BUFSIZE];
+  for (unsigned id = 0; id < PRESET_INDEX_SIZE && success; id++) {
+    if (!presetIndex->pos[id]) continue;
+    if (out.position() > 1) out.write(',');
+    out.printf_P(PSTR("\"%u\":"), id);
+    size_t newPos = out.position();
+    f.seek(presetIndex->pos[id]);
+    for (size_t left = presetIndex->len[id]; left > 0 && success; ) {
+      size_t block = f.read(buf, left > FS_BUFSIZE ? FS_BUFSIZE : left);
+      success = block > 0 && out.write(buf, block) == block;
+      left -= block;
+    }
+    presetIndex->pos[id] = newPos;
+  }
+  success = success && out.write('}') == 1;
+  size_t newSize = out.size();
+  out.close();
+  f.close();
+
+  // an upload that started meanwhile must not be replaced by the compacted old presets
+  if (generation != presetsGeneration) success = false;
+  // rename replaces presets.json in one step, where that fails old and new can only be swapped
+  // with a moment without presets.json: initPresetIndex() then finishes the job
+  if (success && !WLED_FS.rename(newName, fileName)) success = WLED_FS.remove(fileName) && WLED_FS.rename(newName, fileName);
+  if (!success) {
+    WLED_FS.remove(newName);
+    return false;
+  }
+  presetIndex->fileSize = newSize;
+  presetIndex->truncated = false;
+  presetIndexValid = generation == presetsGeneration;
+  presetsModifiedTime = toki.second(); //unix time
+  updateFSInfo();
+  DEBUGFS_PRINTF("Compacted to %u bytes, took %d ms\n", newSize, millis() - s);
+  return true;
+}
+
+// removes the padding from presets.json once enough has accumulated, call when no preset is being used
+bool compactPresetsFile() {
+  if (!presetsCompactionDue || !requestJSONBufferLock(23)) return false; // the lock keeps other users of f away
+  presetsCompactionDue = false;
+  if (doCloseFile) closeFile();
+  bool success = rewritePresetsFile();
+  releaseJSONBufferLock();
+  return success;
+}
+
+// finishes or discards an interrupted compaction, indexes presets.json and repairs it if it was cut off (call at boot)
+void initPresetIndex() {
+  if (doCloseFile) closeFile();
+  char fileName[33]; strncpy_P(fileName, getPresetsFileName(), 32); fileName[32] = 0; //use PROGMEM safe copy as FS.open() does not
+  char newName[33];  strncpy_P(newName, presets_new, 32); newName[32] = 0;
+  if (WLED_FS.exists(newName)) {
+    if (WLED_FS.exists(fileName)) WLED_FS.remove(newName); // compaction did not complete, presets.json is untouched
+    else                          WLED_FS.rename(newName, fileName);
+  }
+
+  f = WLED_FS.open(fileName, "r");
+  if (!f) return;
+  bool truncated = buildPresetIndex() && presetIndex->truncated && f.size() > 2;
+  f.close();
+  if (truncated) {
+    DEBUG_PRINTLN(F("presets.json is cut off, repairing."));
+    rewritePresetsFile();
+  }
+}
+
+// id is the preset ID if file is the presets file (as returned by getPresetsFileName()), -1 otherwise
+static bool writeObject(const char* file, const char* key, int id, const JsonDocument* content)
 {
   uint32_t s = 0; //timing
   #ifdef WLED_DEBUG_FS
@@ -278,8 +529,10 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     DEBUGFS_PRINTLN(F("Failed to open!"));
     return false;
   }
+  writeSizeBefore = f.size();
+  writePos = writeLen = 0;
 
-  if (!bufferedFind(key)) //key does not exist in file
+  if (!(id >= 0 ? findPreset(id, key) : bufferedFind(key))) //key does not exist in file
   {
     return appendObjectToFile(key, content, s);
   }
@@ -305,11 +558,15 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
   if (contentLen && contentLen <= oldLen) { //replace and fill diff with spaces
     DEBUGFS_PRINTLN(F("replace"));
     f.seek(pos);
+    writePos = pos;
+    writeLen = contentLen;
     serializeJson(*content, f);
     writeSpace(pos2 - f.position());
   } else if (contentLen && bufferedFindSpace(contentLen - oldLen, false)) { //enough leading spaces to replace
     DEBUGFS_PRINTLN(F("replace (trailing)"));
     f.seek(pos);
+    writePos = pos;
+    writeLen = contentLen;
     serializeJson(*content, f);
   } else {
     DEBUGFS_PRINTLN(F("delete"));
@@ -325,15 +582,384 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
   return true;
 }
 
-bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter)
+// replaces the entire file with content
+static bool writeWholeFile(const char* fileName, const JsonDocument* content)
+{
+  if (doCloseFile) closeFile();
+  File wf = WLED_FS.open(fileName, "w");
+  if (!wf) return false;
+  bool success = serializeJson(*content, wf) > 0;
+  wf.close();
+  return success;
+}
+
+/*
+ * Journal
+ * Preset writes (writeObjectToFileUsingId() on presets.json) and whole file writes (writeObjectToFile()
+ * without key, cfg.json) are appended to /journal.dat instead of being written into their files.
+ * Changing a LittleFS file in the middle rewrites everything behind that point while an append only
+ * writes the last block, so saves from automations, playlists and settings are short, and repeated
+ * saves of the same preset or file end up as a single write when the journal is folded into the files.
+ * Reads are served from the journal while a record is pending. Records are folded into their files
+ * when no new ones came in for JOURNAL_FOLD_DELAY, when the journal reaches JOURNAL_FOLD_SIZE, before
+ * such a file is served over HTTP, before a restart, and at boot: initJournal() replays what a reset
+ * or power loss left behind, up to the first record that fails its CRC (cut off while written).
+ * When the journal is full a save is written into its file, the record it supersedes is then dropped
+ * by copying the remaining ones to a new journal (compactJournal()), as are records of uploaded files.
+ * Record: type, id, payload length (2 bytes, little endian), payload, crc16 of everything before (2 bytes)
+ *   JOURNAL_PRESET  id: preset ID, payload: MessagePack of the preset (empty to delete it)
+ *   JOURNAL_FILE    id: length of the file name, payload: file name and MessagePack of the content
+ * Whole file records are meant for files that are only ever read and written whole.
+ */
+#define JOURNAL_PRESET      1
+#define JOURNAL_FILE        2
+#define JOURNAL_FILES       2      // files with whole file records pending at the same time
+#define JOURNAL_HEADER      4
+#define JOURNAL_FOLD_SIZE   8192   // fold when the journal gets this large
+#define JOURNAL_MAX_SIZE    65535  // record positions are 16 bit
+#define JOURNAL_FOLD_DELAY  60000  // fold after this long without new records (ms)
+
+typedef struct JournalIndex {
+  uint16_t preset[PRESET_INDEX_SIZE];  // position + 1 of the latest record of each preset, 0 if none
+  uint16_t file[JOURNAL_FILES];        // the same for whole files
+  char     fileName[JOURNAL_FILES][33];
+  uint16_t size;                       // end of the last record
+} journal_index_t;
+
+static journal_index_t *journalIndex = nullptr; // allocated with the first record
+static unsigned long journalLastWrite = 0;
+static volatile bool journalFoldRequested = false;
+static volatile uint8_t journalDiscard = 0; // set by discardJournal(): bit 0 presets, bit 1+n whole file slot n
+static const char journal_dat[] PROGMEM = "/journal.dat";
+static const char journal_new[] PROGMEM = "/journal.new"; // compacted journal before it replaces journal.dat
+
+static int findJournalFile(const char* fileName) {
+  for (int i = 0; i < JOURNAL_FILES; i++) if (journalIndex->file[i] && !strcmp(journalIndex->fileName[i], fileName)) return i;
+  return -1;
+}
+
+// position + 1 of the pending record of preset id (id >= 0) or file fileName, 0 if there is none
+static size_t findJournalRecord(int id, const char* fileName) {
+  if (!journalIndex || !journalIndex->size) return 0;
+  if (id >= 0) return id < PRESET_INDEX_SIZE && !(journalDiscard & 1) ? journalIndex->preset[id] : 0;
+  int slot = findJournalFile(fileName);
+  return slot >= 0 && !(journalDiscard & (2 << slot)) ? journalIndex->file[slot] : 0;
+}
+
+static bool journalHasPresets() {
+  if (journalDiscard & 1) return false;
+  for (int id = 0; id < PRESET_INDEX_SIZE; id++) if (journalIndex->preset[id]) return true;
+  return false;
+}
+
+// reads the record at pos, returns it (free() when done) if it is complete and its CRC matches
+static uint8_t *readJournalRecord(File &jf, size_t pos, size_t &len) {
+  uint8_t header[JOURNAL_HEADER];
+  if (!jf.seek(pos) || jf.read(header, JOURNAL_HEADER) != JOURNAL_HEADER) return nullptr;
+  len = JOURNAL_HEADER + (header[2] | header[3] << 8) + 2;
+  if (pos + len > jf.size() || (header[0] == JOURNAL_FILE && (header[1] == 0 || header[1] > 32))) return nullptr;
+  uint8_t *record = static_cast<uint8_t*>(malloc(len));
+  if (!record) return nullptr;
+  memcpy(record, header, JOURNAL_HEADER);
+  if (jf.read(record + JOURNAL_HEADER, len - JOURNAL_HEADER) == len - JOURNAL_HEADER
+      && crc16(record, len - 2) == (record[len-2] | record[len-1] << 8)) return record;
+  free(record);
+  return nullptr;
+}
+
+// appends a record for preset id (type JOURNAL_PRESET) or file fileName (JOURNAL_FILE)
+static bool appendJournal(uint8_t type, uint8_t id, const char* fileName, const JsonDocument* content) {
+  if (!journalIndex) {
+    journalIndex = static_cast<journal_index_t*>(calloc(1, sizeof(journal_index_t)));
+    if (!journalIndex) return false;
+  }
+  int slot = -1;
+  size_t nameLen = 0;
+  if (type == JOURNAL_FILE) {
+    nameLen = strlen(fileName);
+    if (nameLen == 0 || nameLen > 32) return false;
+    slot = findJournalFile(fileName);
+    for (int i = 0; i < JOURNAL_FILES && slot < 0; i++) if (!journalIndex->file[i]) slot = i;
+    if (slot < 0) return false;
+    id = nameLen;
+  }
+  size_t docLen = content->isNull() ? 0 : measureMsgPack(*content);
+  size_t len = JOURNAL_HEADER + nameLen + docLen + 2;
+  if (journalIndex->size + len > JOURNAL_MAX_SIZE) {
+    journalFoldRequested = true;
+    return false;
+  }
+  uint8_t *record = static_cast<uint8_t*>(malloc(len));
+  if (!record) return false;
+  record[0] = type;
+  record[1] = id;
+  record[2] = (nameLen + docLen) & 0xFF;
+  record[3] = (nameLen + docLen) >> 8;
+  memcpy(record + JOURNAL_HEADER, fileName, nameLen);
+  if (docLen) serializeMsgPack(*content, record + JOURNAL_HEADER + nameLen, docLen);
+  uint16_t crc = crc16(record, len - 2);
+  record[len-2] = crc & 0xFF;
+  record[len-1] = crc >> 8;
+
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTF("Journal %u bytes at %u\n", len, journalIndex->size);
+    uint32_t s = millis();
+  #endif
+  if (doCloseFile) closeFile();
+  char journalName[16]; strcpy_P(journalName, journal_dat);
+  File jf = WLED_FS.open(journalName, journalIndex->size ? "r+" : "w"); // a cut off record is overwritten
+  bool success = jf && jf.seek(journalIndex->size) && jf.write(record, len) == len;
+  if (jf) jf.close();
+  free(record);
+  if (!success) return false;
+
+  size_t pos = journalIndex->size + 1;
+  if (type == JOURNAL_PRESET) journalIndex->preset[id] = pos;
+  else {
+    journalIndex->file[slot] = pos;
+    strcpy(journalIndex->fileName[slot], fileName);
+  }
+  journalIndex->size += len;
+  journalLastWrite = millis();
+  DEBUGFS_PRINTF("Journaled, took %d ms\n", millis() - s);
+  return true;
+}
+
+// reads a pending record into dest, false if it deletes the preset or cannot be read
+static bool readJournal(size_t pos, JsonDocument* dest, const JsonDocument* filter) {
+  dest->clear();
+  char journalName[16]; strcpy_P(journalName, journal_dat);
+  File jf = WLED_FS.open(journalName, "r");
+  if (!jf) return false;
+  size_t len;
+  uint8_t *record = readJournalRecord(jf, pos - 1, len);
+  jf.close();
+  if (!record) return false;
+  size_t skip = JOURNAL_HEADER + (record[0] == JOURNAL_FILE ? record[1] : 0);
+  bool success = len - 2 > skip;
+  if (success) { // const input: strings are copied into dest
+    const char *doc = reinterpret_cast<const char*>(record + skip);
+    if (filter) success = !deserializeMsgPack(*dest, doc, len - 2 - skip, DeserializationOption::Filter(*filter));
+    else        success = !deserializeMsgPack(*dest, doc, len - 2 - skip);
+  }
+  free(record);
+  return success;
+}
+
+// copies the pending records to journal.new and replaces journal.dat with it, removes the journal if
+// none are left: superseded and discarded records are then neither folded nor replayed (JSON buffer lock held)
+static bool compactJournal() {
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Compact journal"));
+    uint32_t s = millis();
+  #endif
+  char journalName[16]; strcpy_P(journalName, journal_dat);
+  char newName[16];     strcpy_P(newName, journal_new);
+  uint16_t newPos[PRESET_INDEX_SIZE + JOURNAL_FILES];
+  size_t size = 0;
+  File jf = WLED_FS.open(journalName, "r");
+  File out;
+  bool success = jf;
+  for (int id = 0; id < PRESET_INDEX_SIZE + JOURNAL_FILES && success; id++) {
+    uint16_t pos = id < PRESET_INDEX_SIZE ? journalIndex->preset[id] : journalIndex->file[id - PRESET_INDEX_SIZE];
+    newPos[id] = 0;
+    if (!pos) continue;
+    size_t len;
+    uint8_t *record = readJournalRecord(jf, pos - 1, len);
+    if (!record) continue; // cannot happen unless the journal was changed behind our back
+    if (!out) out = WLED_FS.open(newName, "w");
+    success = out && out.write(record, len) == len;
+    free(record);
+    newPos[id] = size + 1;
+    size += len;
+  }
+  if (jf) jf.close();
+  if (out) out.close();
+  if (!success) {
+    WLED_FS.remove(newName);
+    return false;
+  }
+  // as for presets.new, initJournal() finishes the job if old and new could only be swapped
+  if (!size) WLED_FS.remove(journalName);
+  else if (!WLED_FS.rename(newName, journalName) && !(WLED_FS.remove(journalName) && WLED_FS.rename(newName, journalName))) {
+    WLED_FS.remove(newName);
+    return false;
+  }
+  for (int id = 0; id < PRESET_INDEX_SIZE + JOURNAL_FILES; id++) {
+    if (id < PRESET_INDEX_SIZE) journalIndex->preset[id] = newPos[id];
+    else                        journalIndex->file[id - PRESET_INDEX_SIZE] = newPos[id];
+  }
+  journalIndex->size = size;
+  updateFSInfo();
+  DEBUGFS_PRINTF("Compacted journal to %u bytes, took %d ms\n", size, millis() - s);
+  return true;
+}
+
+// drops the records discardJournal() was asked to drop, from the index and from the journal (JSON buffer lock held)
+static void applyJournalDiscard() {
+  uint8_t discard = journalDiscard;
+  if (!discard) return;
+  journalDiscard = 0;
+  if (!journalIndex || !journalIndex->size) return;
+  if (discard & 1) memset(journalIndex->preset, 0, sizeof(journalIndex->preset));
+  for (int i = 0; i < JOURNAL_FILES; i++) if (discard & (2 << i)) journalIndex->file[i] = 0;
+  if (!compactJournal()) journalFoldRequested = true; // the fold removes them as well
+}
+
+// drops the pending record of preset id (id >= 0) or file fileName after the file was written directly (JSON buffer lock held)
+static void dropJournalRecord(int id, const char* fileName) {
+  if (!findJournalRecord(id, fileName)) return;
+  if (id >= 0) journalIndex->preset[id] = 0;
+  else         journalIndex->file[findJournalFile(fileName)] = 0;
+  if (!compactJournal()) journalFoldRequested = true;
+}
+
+// writes the pending records into their files and removes the journal (JSON buffer lock held)
+static bool doFoldJournal() {
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Fold journal"));
+    uint32_t s = millis();
+  #endif
+  char journalName[16]; strcpy_P(journalName, journal_dat);
+  File jf = WLED_FS.open(journalName, "r");
+  bool success = true, presetsWritten = false;
+  for (int id = 0; id < PRESET_INDEX_SIZE + JOURNAL_FILES && jf; id++) {
+    uint16_t &pos = id < PRESET_INDEX_SIZE ? journalIndex->preset[id] : journalIndex->file[id - PRESET_INDEX_SIZE];
+    if (!pos) continue;
+    size_t len;
+    uint8_t *record = readJournalRecord(jf, pos - 1, len);
+    if (!record) { // cannot happen unless the journal was changed behind our back
+      pos = 0;
+      continue;
+    }
+    size_t skip = JOURNAL_HEADER + (record[0] == JOURNAL_FILE ? record[1] : 0);
+    pDoc->clear();
+    if (len - 2 > skip) deserializeMsgPack(*pDoc, reinterpret_cast<const char*>(record + skip), len - 2 - skip);
+    free(record);
+    bool written;
+    if (id < PRESET_INDEX_SIZE) {
+      char objKey[10];
+      sprintf(objKey, "\"%d\":", id);
+      written = writeObject(getPresetsFileName(), objKey, id, pDoc);
+      updatePresetIndex(id, written);
+      if (doCloseFile) closeFile();
+      presetsWritten |= written;
+    } else {
+      written = writeWholeFile(journalIndex->fileName[id - PRESET_INDEX_SIZE], pDoc);
+    }
+    if (written) pos = 0;
+    success &= written;
+  }
+  pDoc->clear();
+  if (jf) jf.close();
+  if (success) { // else the records that are left are retried with the next fold
+    WLED_FS.remove(journalName);
+    journalIndex->size = 0;
+  }
+  if (presetsWritten) presetsModifiedTime = toki.second(); //unix time
+  updateFSInfo();
+  DEBUGFS_PRINTF("Folded, took %d ms\n", millis() - s);
+  return success;
+}
+
+// folds the journal into the files if that is due (or forced), call when no preset is being used
+bool foldJournal(bool force) {
+  if (!journalIndex || !journalIndex->size) return false;
+  if (!force && !journalFoldRequested && journalIndex->size < JOURNAL_FOLD_SIZE && millis() - journalLastWrite < JOURNAL_FOLD_DELAY) return false;
+  if (!requestJSONBufferLock(25)) return false; // the lock keeps other users of f and the journal away
+  journalFoldRequested = false;
+  unsigned long start = millis();
+  while (strip.isUpdating() && millis()-start < (2*FRAMETIME_FIXED)+1) yield(); // wait 2 frames
+  if (doCloseFile) closeFile();
+  applyJournalDiscard();
+  bool success = doFoldJournal();
+  releaseJSONBufferLock();
+  return success;
+}
+
+// drops pending records of a file that is being replaced (upload): they are no longer read right away,
+// the loop removes them from the journal with the fold requested here (called without the JSON buffer lock)
+void discardJournal(const char* file) {
+  if (!journalIndex || !journalIndex->size) return;
+  char fileName[33]; strncpy_P(fileName, file, 32); fileName[32] = 0;
+  uint8_t discard = 0;
+  if (!strcmp_P(fileName, getPresetsFileName()) && journalHasPresets()) discard |= 1;
+  int slot = findJournalFile(fileName);
+  if (slot >= 0) discard |= 2 << slot;
+  if (!discard) return;
+  journalDiscard |= discard;
+  journalFoldRequested = true;
+}
+
+// indexes the records left in the journal and folds them into their files (call at boot, after initPresetIndex())
+void initJournal() {
+  char journalName[16]; strcpy_P(journalName, journal_dat);
+  char newName[16];     strcpy_P(newName, journal_new);
+  if (WLED_FS.exists(newName)) {
+    if (WLED_FS.exists(journalName)) WLED_FS.remove(newName); // compaction did not complete, journal.dat is untouched
+    else                             WLED_FS.rename(newName, journalName);
+  }
+  File jf = WLED_FS.open(journalName, "r");
+  if (!jf) return;
+  if (!journalIndex) journalIndex = static_cast<journal_index_t*>(calloc(1, sizeof(journal_index_t)));
+  if (!journalIndex) {
+    jf.close();
+    return;
+  }
+  size_t pos = 0, len;
+  uint8_t *record;
+  while (pos < JOURNAL_MAX_SIZE && (record = readJournalRecord(jf, pos, len))) {
+    if (record[0] == JOURNAL_PRESET && record[1] < PRESET_INDEX_SIZE) journalIndex->preset[record[1]] = pos + 1;
+    else if (record[0] == JOURNAL_FILE) {
+      char fileName[33];
+      memcpy(fileName, record + JOURNAL_HEADER, record[1]);
+      fileName[record[1]] = 0;
+      int slot = findJournalFile(fileName);
+      for (int i = 0; i < JOURNAL_FILES && slot < 0; i++) if (!journalIndex->file[i]) slot = i;
+      if (slot >= 0) {
+        journalIndex->file[slot] = pos + 1;
+        strcpy(journalIndex->fileName[slot], fileName);
+      }
+    }
+    free(record);
+    if (pos + len > JOURNAL_MAX_SIZE) break;
+    pos += len;
+  }
+  DEBUG_PRINTF_P(PSTR("Journal: %u of %u bytes valid.\n"), pos, jf.size());
+  jf.close();
+  journalIndex->size = pos;
+  if (pos) foldJournal(true);
+  else     WLED_FS.remove(journalName);
+}
+
+bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content)
 {
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
-  return readObjectFromFile(file, objKey, dest, filter);
+  if (file != getPresetsFileName() || id >= PRESET_INDEX_SIZE) return writeObject(file, objKey, -1, content);
+  invalidatePresetCache(id);
+  applyJournalDiscard();
+  if (appendJournal(JOURNAL_PRESET, id, nullptr, content)) return true;
+  bool success = writeObject(file, objKey, id, content); // journal full: write the file directly
+  updatePresetIndex(id, success);
+  if (success) dropJournalRecord(id, nullptr); // an older version must not be folded or replayed over it
+  return success;
 }
 
-//if the key is a nullptr, deserialize entire object
-bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter)
+//if the key is a nullptr, replace the entire file
+bool writeObjectToFile(const char* file, const char* key, const JsonDocument* content)
+{
+  if (key != nullptr) return writeObject(file, key, -1, content);
+  char fileName[33]; strncpy_P(fileName, file, 32); fileName[32] = 0; //use PROGMEM safe copy as FS.open() does not
+  applyJournalDiscard();
+  if (appendJournal(JOURNAL_FILE, 0, fileName, content)) return true;
+  bool success = writeWholeFile(fileName, content); // journal full: write the file directly
+  if (success) dropJournalRecord(-1, fileName); // an older version must not be folded or replayed over it
+  return success;
+}
+
+// id as for writeObject(), if the key is a nullptr, deserialize entire object
+static bool readObject(const char* file, const char* key, int id, JsonDocument* dest, const JsonDocument* filter)
 {
   if (doCloseFile) closeFile();
   #ifdef WLED_DEBUG_FS
@@ -341,10 +967,16 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, c
     uint32_t s = millis();
   #endif
   char fileName[129]; strncpy_P(fileName, file, 128); fileName[128] = 0; //use PROGMEM safe copy as FS.open() does not
+  size_t journalPos = (id >= 0 || key == nullptr) ? findJournalRecord(id, fileName) : 0; // a pending record is newer than the file
+  if (journalPos) {
+    bool success = readJournal(journalPos, dest, filter);
+    DEBUGFS_PRINTF("Read from journal, took %d ms\n", millis() - s);
+    return success;
+  }
   f = WLED_FS.open(fileName, "r");
   if (!f) return false;
 
-  if (key != nullptr && !bufferedFind(key)) //key does not exist in file
+  if (key != nullptr && !(id >= 0 ? findPreset(id, key) : bufferedFind(key))) //key does not exist in file
   {
     f.close();
     dest->clear();
@@ -360,6 +992,19 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, c
   return true;
 }
 
+bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter)
+{
+  char objKey[10];
+  sprintf(objKey, "\"%d\":", id);
+  return readObject(file, objKey, (file == getPresetsFileName() && id < PRESET_INDEX_SIZE) ? id : -1, dest, filter);
+}
+
+//if the key is a nullptr, deserialize entire object
+bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter)
+{
+  return readObject(file, key, -1, dest, filter);
+}
+
 void updateFSInfo() {
   #ifdef ARDUINO_ARCH_ESP32
     #if WLED_FS == LITTLEFS || ESP_IDF_VERSION_MAJOR >= 4
@@ -422,6 +1067,14 @@ bool handleFileRead(AsyncWebServerRequest* request, String path){
   DEBUG_PRINT(F("WS FileRead: ")); DEBUG_PRINTLN(path);
   if(path.endsWith("/")) path += "index.htm";
   if(path.indexOf(F("sec")) > -1) return false;
+  if (journalIndex && journalIndex->size && path.length() <= 32) { // serve the file once pending records are folded into it
+    bool pending = path.equals(FPSTR(getPresetsFileName())) ? journalHasPresets() : findJournalRecord(-1, path.c_str());
+    if (pending) {
+      journalFoldRequested = true;
+      request->deferResponse();
+      return true;
+    }
+  }
   #ifdef ARDUINO_ARCH_ESP32
   if (psramSafe && psramFound() && path.endsWith(FPSTR(getPresetsFileName()))) {
     size_t psize;
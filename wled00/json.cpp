@@ -232,6 +232,7 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
   seg.check1 = getBoolVal(elem["o1"], seg.check1);
   seg.check2 = getBoolVal(elem["o2"], seg.check2);
   seg.check3 = getBoolVal(elem["o3"], seg.check3);
+  getVal(elem["bm"], &seg.blendMode, 0, SEG_BLEND_COUNT-1); // only effective with segment buffers
 
   JsonArray iarr = elem[F("i")]; //set individual LEDs
   if (!iarr.isNull()) {
@@ -342,7 +343,7 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
   }
 
   tr = root[F("tb")] | -1;
-  if (tr >= 0) strip.timebase = (unsigned long)tr - millis();
+  if (tr >= 0) strip.timebase = (unsigned long)tr - strip.clockMillis();
 
   JsonObject nl       = root["nl"];
   nightlightActive    = getBoolVal(nl["on"], nightlightActive);
@@ -561,9 +562,11 @@ void serializeSegment(const JsonObject& root, const Segment& seg, byte id, bool
   root["o3"]  = seg.check3;
   root["si"]  = seg.soundSim;
   root["m12"] = seg.map1D2D;
+  root["bm"]  = seg.blendMode;
 }
 
-void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
+// everything in the state object but the segments
+static void serializeStateSettings(JsonObject root, bool forPreset, bool includeBri)
 {
   if (includeBri) {
     root["on"] = (bri > 0);
@@ -600,6 +603,11 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 
   root[F("mainseg")] = strip.getMainSegmentId();
+}
+
+void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
+{
+  serializeStateSettings(root, forPreset, includeBri);
 
   JsonArray seg = root.createNestedArray("seg");
   for (size_t s = 0; s < strip.getMaxSegments(); s++) {
@@ -623,6 +631,14 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 }
 
+// frame times as [min,avg,max] in us
+static void serializeFrameTime(JsonArray arr, const frame_time_t &t)
+{
+  arr.add(t.getMin());
+  arr.add(t.getAvg());
+  arr.add(t.getMax());
+}
+
 void serializeInfo(JsonObject root)
 {
   root[F("ver")] = versionString;
@@ -664,6 +680,18 @@ void serializeInfo(JsonObject root)
   leds[F("wv")]   = totalLC & 0x02;     // deprecated, true if white slider should be displayed for any segment
   leds["cct"]     = totalLC & 0x04;     // deprecated, use info.leds.lc
 
+  // frame time summary [min,avg,max] in us, details in /json/perf
+  const frame_stats_t &fs = strip.getFrameStats();
+  JsonObject perf = leds.createNestedObject(F("perf"));
+  serializeFrameTime(perf.createNestedArray(F("frame")), fs.frame);
+  serializeFrameTime(perf.createNestedArray("fx"),       fs.fx);
+  serializeFrameTime(perf.createNestedArray(F("blend")), fs.blend);
+  serializeFrameTime(perf.createNestedArray(F("show")),  fs.show);
+  serializeFrameTime(perf.createNestedArray(F("bus")),   fs.bus);
+  serializeFrameTime(perf.createNestedArray(F("ovl")),   fs.overlay);
+  serializeFrameTime(perf.createNestedArray(F("comp")),  fs.comp);
+  serializeFrameTime(perf.createNestedArray(F("xf")),    fs.xfade);
+
   #ifdef WLED_DEBUG
   JsonArray i2c = root.createNestedArray(F("i2c"));
   i2c.add(i2c_sda);
@@ -696,6 +724,23 @@ void serializeInfo(JsonObject root)
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
 
+  uint8_t poolAllocated, poolInUse;
+  getJSONPoolUsage(poolAllocated, poolInUse);
+  JsonObject jbuf = root.createNestedObject(F("jbuf"));
+  jbuf[F("pool")] = poolAllocated; // response documents allocated
+  jbuf[F("use")]  = poolInUse;
+  jbuf[F("rej")]  = jsonBufferRejected; // requests that found no free buffer
+
+  if (clockSync) {
+    const clock_sync_status_t &cs = getClockSyncStatus();
+    JsonObject clk = root.createNestedObject(F("clk"));
+    clk[F("lock")] = cs.locked;
+    clk[F("master")] = cs.master[0] == 0 ? "" : cs.master.toString(); // empty: this node is the master
+    clk[F("off")] = (int32_t)(cs.offset / 1000); // ms, microseconds need 64 bit which ArduinoJson does not use here
+    clk[F("dly")] = cs.delay;
+    clk[F("err")] = cs.error;
+  }
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -858,69 +903,74 @@ void setPaletteColors(JsonArray json, byte* tcp)
     }
 }
 
-void serializePalettes(JsonObject root, int page)
+// adds palette i (custom palettes follow the built in ones) to the palettes object, keyed by its id
+static void serializePalette(JsonObject palettes, int i)
 {
   byte tcp[72];
+  int palettesCount = strip.getPaletteCount() - strip.customPalettes.size();
+
+  JsonArray curPalette = palettes.createNestedArray(String(i>=palettesCount ? 255 - i + palettesCount : i));
+  switch (i) {
+    case 0: //default palette
+      setPaletteColors(curPalette, PartyColors_p);
+      break;
+    case 1: //random
+      for (int j = 0; j < 4; j++) curPalette.add("r");
+      break;
+    case 2: //primary color only
+      curPalette.add("c1");
+      break;
+    case 3: //primary + secondary
+      curPalette.add("c1");
+      curPalette.add("c1");
+      curPalette.add("c2");
+      curPalette.add("c2");
+      break;
+    case 4: //primary + secondary + tertiary
+      curPalette.add("c3");
+      curPalette.add("c2");
+      curPalette.add("c1");
+      break;
+    case 5: //primary + secondary (+tertiary if not off), more distinct
+      for (int j = 0; j < 5; j++) curPalette.add("c1");
+      for (int j = 0; j < 5; j++) curPalette.add("c2");
+      for (int j = 0; j < 5; j++) curPalette.add("c3");
+      curPalette.add("c1");
+      break;
+    default:
+      if (i >= palettesCount)
+        setPaletteColors(curPalette, strip.customPalettes[i - palettesCount]);
+      else if (i < 13) // palette 6 - 12, fastled palettes
+        setPaletteColors(curPalette, *fastledPalettes[i-6]);
+      else {
+        memcpy_P(tcp, (byte*)pgm_read_dword(&(gGradientPalettes[i - 13])), 72);
+        setPaletteColors(curPalette, tcp);
+      }
+      break;
+  }
+}
+
+void serializePalettes(JsonObject root, int page)
+{
   #ifdef ESP8266
   int itemPerPage = 5;
   #else
   int itemPerPage = 8;
   #endif
 
-  int customPalettes = strip.customPalettes.size();
-  int palettesCount = strip.getPaletteCount() - customPalettes;
+  int palettesCount = strip.getPaletteCount();
 
-  int maxPage = (palettesCount + customPalettes -1) / itemPerPage;
+  int maxPage = (palettesCount -1) / itemPerPage;
   if (page > maxPage) page = maxPage;
 
   int start = itemPerPage * page;
   int end = start + itemPerPage;
-  if (end > palettesCount + customPalettes) end = palettesCount + customPalettes;
+  if (end > palettesCount) end = palettesCount;
 
   root[F("m")] = maxPage; // inform caller how many pages there are
   JsonObject palettes  = root.createNestedObject("p");
 
-  for (int i = start; i < end; i++) {
-    JsonArray curPalette = palettes.createNestedArray(String(i>=palettesCount ? 255 - i + palettesCount : i));
-    switch (i) {
-      case 0: //default palette
-        setPaletteColors(curPalette, PartyColors_p);
-        break;
-      case 1: //random
-           for (int j = 0; j < 4; j++) curPalette.add("r");
-        break;
-      case 2: //primary color only
-        curPalette.add("c1");
-        break;
-      case 3: //primary + secondary
-        curPalette.add("c1");
-        curPalette.add("c1");
-        curPalette.add("c2");
-        curPalette.add("c2");
-        break;
-      case 4: //primary + secondary + tertiary
-        curPalette.add("c3");
-        curPalette.add("c2");
-        curPalette.add("c1");
-        break;
-      case 5: //primary + secondary (+tertiary if not off), more distinct
-        for (int j = 0; j < 5; j++) curPalette.add("c1");
-        for (int j = 0; j < 5; j++) curPalette.add("c2");
-        for (int j = 0; j < 5; j++) curPalette.add("c3");
-        curPalette.add("c1");
-        break;
-      default:
-        if (i >= palettesCount)
-          setPaletteColors(curPalette, strip.customPalettes[i - palettesCount]);
-        else if (i < 13) // palette 6 - 12, fastled palettes
-          setPaletteColors(curPalette, *fastledPalettes[i-6]);
-        else {
-          memcpy_P(tcp, (byte*)pgm_read_dword(&(gGradientPalettes[i - 13])), 72);
-          setPaletteColors(curPalette, tcp);
-        }
-        break;
-    }
-  }
+  for (int i = start; i < end; i++) serializePalette(palettes, i);
 }
 
 void serializeNetworks(JsonObject root)
@@ -952,29 +1002,122 @@ void serializeNetworks(JsonObject root)
   }
 }
 
+static void serializeNode(JsonObject node, const NodeStruct &n)
+{
+  node[F("name")] = n.nodeName;
+  node["type"]    = n.nodeType;
+  node["ip"]      = n.ip.toString();
+  node[F("age")]  = n.age;
+  node[F("vid")]  = n.build;
+}
+
 void serializeNodes(JsonObject root)
 {
   JsonArray nodes = root.createNestedArray("nodes");
 
   for (NodesMap::iterator it = Nodes.begin(); it != Nodes.end(); ++it)
   {
-    if (it->second.ip[0] != 0)
-    {
-      JsonObject node = nodes.createNestedObject();
-      node[F("name")] = it->second.nodeName;
-      node["type"]    = it->second.nodeType;
-      node["ip"]      = it->second.ip.toString();
-      node[F("age")]  = it->second.age;
-      node[F("vid")]  = it->second.build;
-    }
+    if (it->second.ip[0] != 0) serializeNode(nodes.createNestedObject(), it->second);
   }
 }
 
-// deserializes mode data string into JsonArray
-void serializeModeData(JsonArray fxdata)
+static void serializeFrameStat(JsonObject obj, const frame_stat_t &t)
+{
+  obj[F("last")] = t.last;
+  obj[F("min")]  = t.getMin();
+  obj[F("avg")]  = t.getAvg();
+  obj[F("max")]  = t.getMax();
+  obj["n"]       = t.count;
+  JsonArray hist = obj.createNestedArray(F("hist"));
+  for (unsigned i = 0; i < FRAME_STAT_BUCKETS; i++) hist.add(t.hist[i]);
+}
+
+#ifdef WLED_ENABLE_RT_LATENCY
+// [p50,p90,p99,max] of n samples (sorts them)
+static void serializePercentiles(JsonArray arr, uint32_t *v, unsigned n)
+{
+  std::sort(v, v + n);
+  arr.add(n ? v[n*50/100] : 0);
+  arr.add(n ? v[n*90/100] : 0);
+  arr.add(n ? v[n*99/100] : 0);
+  arr.add(n ? v[n-1] : 0);
+}
+
+// realtime packet-to-photon latency percentiles (us) of the last RT_LATENCY_SAMPLES frames
+void serializeRealtimeLatency(JsonObject root)
+{
+  const rt_latency_t &rl = getRealtimeLatency();
+  const unsigned n = min(rl.count, (uint32_t)RT_LATENCY_SAMPLES);
+  uint32_t v[RT_LATENCY_SAMPLES];
+  root["n"] = rl.count;
+  root[F("merged")] = rl.merged;
+  memcpy(v, rl.ingest, n * sizeof(uint32_t));
+  serializePercentiles(root.createNestedArray(F("ingest")), v, n);
+  memcpy(v, rl.wait, n * sizeof(uint32_t));
+  serializePercentiles(root.createNestedArray(F("wait")), v, n);
+  memcpy(v, rl.bus, n * sizeof(uint32_t));
+  serializePercentiles(root.createNestedArray(F("bus")), v, n);
+  for (unsigned i = 0; i < n; i++) v[i] = rl.ingest[i] + rl.wait[i] + rl.bus[i];
+  serializePercentiles(root.createNestedArray(F("total")), v, n);
+}
+#endif
+
+// frame time statistics (all times in us)
+void serializePerf(JsonObject root)
+{
+  root["fps"] = strip.getFps();
+  root[F("ft")] = strip.getFrameTime() * 1000; // target frame time
+  JsonArray bins = root.createNestedArray(F("bins")); // histogram bucket upper bounds (last bucket is open ended)
+  for (unsigned i = 0; i < FRAME_STAT_BUCKETS-1; i++) bins.add(FrameStat::bucketLimit(i));
+
+  const frame_stats_t &fs = strip.getFrameStats();
+  serializeFrameStat(root.createNestedObject(F("frame")), fs.frame);
+  serializeFrameStat(root.createNestedObject("fx"),       fs.fx);
+  serializeFrameStat(root.createNestedObject(F("blend")), fs.blend);
+  serializeFrameStat(root.createNestedObject(F("show")),  fs.show);
+  serializeFrameStat(root.createNestedObject(F("bus")),   fs.bus);
+  serializeFrameStat(root.createNestedObject(F("ovl")),   fs.overlay);
+  serializeFrameStat(root.createNestedObject(F("comp")),  fs.comp);
+  serializeFrameStat(root.createNestedObject(F("xf")),    fs.xfade);
+  #ifndef WLED_DISABLE_MODE_BLEND
+  JsonObject xfPool = root.createNestedObject(F("xfpool")); // crossfade scratch pool (bytes)
+  xfPool[F("size")] = Segment::getXfadePoolSize() * sizeof(uint32_t);
+  xfPool[F("used")] = Segment::getXfadePoolUsed() * sizeof(uint32_t);
+  xfPool[F("max")]  = MAX_XFADE_PIXELS * sizeof(uint32_t);
+  #endif
+
+  #ifdef WLED_ENABLE_RT_LATENCY
+  serializeRealtimeLatency(root.createNestedObject("rt")); // realtime packet-to-photon latency
+  #endif
+
+  JsonObject pwr = root.createNestedObject(F("pwr")); // ABL current estimate of the last frame (mA)
+  pwr[F("used")] = BusManager::currentMilliamps();
+  pwr[F("max")]  = BusManager::ablMilliampsMax();
+  JsonArray busPwr = pwr.createNestedArray(F("bus")); // [used,max] per bus, 0 if the bus does no power accounting
+  for (size_t i = 0; i < BusManager::getNumBusses(); i++) {
+    const Bus *bus = BusManager::getBus(i);
+    JsonArray b = busPwr.createNestedArray();
+    b.add(bus->getUsedCurrent());
+    b.add(bus->getMaxCurrent());
+  }
+
+  JsonArray segs = root.createNestedArray("seg");
+  const std::vector<segment_time_t> &ss = strip.getSegmentStats();
+  for (size_t i = 0; i < ss.size() && i < strip.getSegmentsNum(); i++) {
+    if (!strip.getSegment(i).isActive()) continue;
+    JsonObject seg = segs.createNestedObject();
+    seg["id"] = i;
+    seg["fx"] = ss[i].mode;
+    serializeFrameTime(seg.createNestedArray("t"), ss[i].fx);     // [min,avg,max] effect function
+    serializeFrameTime(seg.createNestedArray("tb"), ss[i].blend); // [min,avg,max] old effect during transition
+  }
+}
+
+// deserializes mode data string into JsonArray (modes start to start+count-1)
+void serializeModeData(JsonArray fxdata, unsigned start, unsigned count)
 {
   char lineBuffer[256];
-  for (size_t i = 0; i < strip.getModeCount(); i++) {
+  for (size_t i = start; i < strip.getModeCount() && i - start < count; i++) {
     strncpy_P(lineBuffer, strip.getModeData(i), sizeof(lineBuffer)/sizeof(char)-1);
     lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
     if (lineBuffer[0] != 0) {
@@ -987,10 +1130,10 @@ void serializeModeData(JsonArray fxdata)
 
 // deserializes mode names string into JsonArray
 // also removes effect data extensions (@...) from deserialised names
-void serializeModeNames(JsonArray arr)
+void serializeModeNames(JsonArray arr, unsigned start, unsigned count)
 {
   char lineBuffer[256];
-  for (size_t i = 0; i < strip.getModeCount(); i++) {
+  for (size_t i = start; i < strip.getModeCount() && i - start < count; i++) {
     strncpy_P(lineBuffer, strip.getModeData(i), sizeof(lineBuffer)/sizeof(char)-1);
     lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
     if (lineBuffer[0] != 0) {
@@ -1001,34 +1144,168 @@ void serializeModeNames(JsonArray arr)
   }
 }
 
-// Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
-class LockedJsonResponse: public AsyncJsonResponse {
-  bool _holding_lock;
+#define JSON_STREAM_BATCH 16 // effect names/data serialized per part
+
+#ifndef RESPONSE_TRY_AGAIN
+#error "AsyncWebServer without RESPONSE_TRY_AGAIN, a busy JSON buffer would truncate streamed /json responses"
+#endif
+
+/*
+ * Streaming (chunked) /json responses
+ * The response is produced part by part while the web server asks for more data: literal text
+ * is copied straight from flash, everything else (the state without segments, a segment, the info
+ * object, a batch of effects, a palette, a node) is serialized into a pool document that is released
+ * as soon as the part has been rendered to text. Memory use is bounded by the largest part instead of
+ * the whole response, the response is not limited to JSON_BUFFER_SIZE and no document is held while
+ * the client is receiving. Parts are read from the live state as they are sent, each one under the
+ * JSON buffer lock so state cannot change while it is serialized.
+ */
+class JsonStream {
   public:
-  // WARNING: constructor assumes requestJSONBufferLock() was successfully acquired externally/prior to constructing the instance
-  // Not a good practice with C++. Unfortunately AsyncJsonResponse only has 2 constructors - for dynamic buffer or existing buffer,
-  // with existing buffer it clears its content during construction
-  // if the lock was not acquired (using JSONBufferGuard class) previous implementation still cleared existing buffer
-  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _holding_lock(true) {};
-
-  virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) { 
-    size_t result = AsyncJsonResponse::_fillBuffer(buf, maxLen);
-    // Release lock as soon as we're done filling content
-    if (((result + _sentLength) >= (_contentLength)) && _holding_lock) {
-      releaseJSONBufferLock();
-      _holding_lock = false;
+    enum class Part : uint8_t { Text, Object, State, ModeNames, ModeData, Palettes, Nodes };
+
+    int page = -1; // palette page, all palettes if negative
+
+    ~JsonStream() { free(_buf); }
+
+    void add(Part part, const char *text = nullptr, void (*fn)(JsonObject) = nullptr) {
+      if (_steps < sizeof(_step)/sizeof(_step[0])) _step[_steps++] = {part, text, fn};
+    }
+    void addText(const char *text) { add(Part::Text, text); } // text in PROGMEM
+
+    // AwsResponseFiller: returns 0 at the end, RESPONSE_TRY_AGAIN if no document is available right now
+    size_t fill(uint8_t *buf, size_t maxLen) {
+      size_t n = 0;
+      while (n < maxLen) {
+        if (_prefix) { buf[n++] = _prefix; _prefix = 0; continue; }
+        if (_pos < _len) {
+          size_t c = min(maxLen - n, _len - _pos);
+          if (_text) memcpy_P(buf + n, _text + _pos, c);
+          else       memcpy(buf + n, _buf + _pos, c);
+          n += c;
+          _pos += c;
+          continue;
+        }
+        uint8_t r = next();
+        if (r == Done) break;
+        if (r == Busy) return n ? n : RESPONSE_TRY_AGAIN;
+      }
+      return n;
     }
-    return result;
-  }
 
-  // destructor will remove JSON buffer lock when response is destroyed in AsyncWebServer
-  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
+  private:
+    enum { Done, Ready, Busy };
+    struct Step { Part part; const char *text; void (*fn)(JsonObject); };
+
+    Step     _step[10];
+    uint8_t  _steps = 0, _cur = 0, _sub = 0;
+    unsigned _idx = 0, _items = 0; // position within the current step, items sent
+    char    *_buf = nullptr;       // rendered part
+    size_t   _cap = 0;
+    const char *_text = nullptr;   // or literal text
+    size_t   _pos = 0, _len = 0;   // window of the part still to be sent
+    char     _prefix = 0;          // sent before the window (item separator)
+
+    void setText(const char *text) { _text = text; _pos = 0; _len = strlen_P(text); }
+    void advance() { _cur++; _sub = 0; _idx = _items = 0; }
+
+    // serializes a part into _buf, false if no document or memory is available (try again later)
+    template<typename F> bool render(F fn) {
+      JsonDocument *doc = requestJSONDocument(17); // holds the buffer lock while the part is read from state
+      if (!doc) return false;
+      fn(*doc);
+      unlockJSONDocument(doc);
+      size_t len = measureJson(*doc) + 1;
+      if (len > _cap) {
+        char *buf = (char*)realloc(_buf, len);
+        if (!buf) { releaseJSONDocument(doc); return false; }
+        _buf = buf;
+        _cap = len;
+      }
+      _len = serializeJson(*doc, _buf, _cap);
+      releaseJSONDocument(doc);
+      _text = nullptr;
+      _pos = 0;
+      return true;
+    }
+
+    // after render(): send the members or elements only (without the enclosing brackets), comma separated
+    void asItems() {
+      _pos = 1;
+      if (_len > 0) _len--;
+      if (_pos < _len && _items++) _prefix = ',';
+    }
+
+    uint8_t next() {
+      while (_cur < _steps) {
+        const Step &s = _step[_cur];
+        switch (s.part) {
+          case Part::Text:
+            setText(s.text);
+            advance();
+            return Ready;
+          case Part::Object:
+            if (!render([&s](JsonDocument &d) { s.fn(d.to<JsonObject>()); })) return Busy;
+            advance();
+            return Ready;
+          case Part::State: // {<settings>,"seg":[<segment>,...]}
+            if (_sub == 0) {
+              if (!render([](JsonDocument &d) { serializeStateSettings(d.to<JsonObject>(), false, true); })) return Busy;
+              if (_len > 0) _len--; // closing brace is sent after the segments
+              _sub++;
+              return Ready;
+            }
+            if (_sub == 1) { setText(PSTR(",\"seg\":[")); _sub++; return Ready; }
+            while (_idx < strip.getSegmentsNum() && !strip.getSegment(_idx).isActive()) _idx++;
+            if (_idx >= strip.getSegmentsNum()) { setText(PSTR("]}")); advance(); return Ready; }
+            if (!render([this](JsonDocument &d) { serializeSegment(d.to<JsonObject>(), strip.getSegment(_idx), _idx); })) return Busy;
+            if (_items++) _prefix = ',';
+            _idx++;
+            return Ready;
+          case Part::ModeNames:
+          case Part::ModeData:
+            if (_sub == 0) { setText(PSTR("[")); _sub++; return Ready; }
+            if (_idx >= strip.getModeCount()) { setText(PSTR("]")); advance(); return Ready; }
+            if (!render([this, &s](JsonDocument &d) {
+              if (s.part == Part::ModeNames) serializeModeNames(d.to<JsonArray>(), _idx, JSON_STREAM_BATCH);
+              else                           serializeModeData(d.to<JsonArray>(), _idx, JSON_STREAM_BATCH);
+            })) return Busy;
+            asItems();
+            _idx += JSON_STREAM_BATCH;
+            return Ready;
+          case Part::Palettes:
+            if (page >= 0) {
+              if (!render([this](JsonDocument &d) { serializePalettes(d.to<JsonObject>(), page); })) return Busy;
+              advance();
+              return Ready;
+            }
+            if (_sub == 0) { setText(PSTR("{\"m\":0,\"p\":{")); _sub++; return Ready; } // a single page
+            if (_idx >= strip.getPaletteCount()) { setText(PSTR("}}")); advance(); return Ready; }
+            if (!render([this](JsonDocument &d) { serializePalette(d.to<JsonObject>(), _idx); })) return Busy;
+            asItems();
+            _idx++;
+            return Ready;
+          case Part::Nodes: { // {"nodes":[<node>,...]}, walked by unit ID as the map may change in between
+            if (_sub == 0) { setText(PSTR("{\"nodes\":[")); _sub++; return Ready; }
+            // unit IDs are uint8_t: after ID 255 the walk is done (lower_bound() would wrap to 0 and start over)
+            NodesMap::iterator it = _idx > UINT8_MAX ? Nodes.end() : Nodes.lower_bound(_idx);
+            while (it != Nodes.end() && it->second.ip[0] == 0) ++it;
+            if (it == Nodes.end()) { setText(PSTR("]}")); advance(); return Ready; }
+            if (!render([&it](JsonDocument &d) { serializeNode(d.to<JsonObject>(), it->second); })) return Busy;
+            if (_items++) _prefix = ',';
+            _idx = it->first + 1;
+            return Ready;
+          }
+        }
+      }
+      return Done;
+    }
 };
 
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
-    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config
+    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config, perf
   };
   json_target subJson = json_target::all;
 
@@ -1042,6 +1319,7 @@ void serveJson(AsyncWebServerRequest* request)
   else if (url.indexOf(F("fxda"))  > 0) subJson = json_target::fxdata;
   else if (url.indexOf(F("net"))   > 0) subJson = json_target::networks;
   else if (url.indexOf(F("cfg"))   > 0) subJson = json_target::config;
+  else if (url.indexOf(F("perf"))  > 0) subJson = json_target::perf;
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
@@ -1057,55 +1335,56 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
-  if (!requestJSONBufferLock(17)) {
-    request->deferResponse();    
+  JsonDocument *doc = requestJSONDocument(17); // parts are serialized into pool documents, make sure one can be had
+  if (!doc) {
+    request->deferResponse();
     return;
   }
-  // releaseJSONBufferLock() will be called when "response" is destroyed (from AsyncWebServer)
-  // make sure you delete "response" if no "request->send(response);" is made
-  LockedJsonResponse *response = new LockedJsonResponse(pDoc, subJson==json_target::fxdata || subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
-
-  JsonVariant lDoc = response->getRoot();
+  releaseJSONDocument(doc);
 
+  std::shared_ptr<JsonStream> stream = std::make_shared<JsonStream>();
   switch (subJson)
   {
     case json_target::state:
-      serializeState(lDoc); break;
+      stream->add(JsonStream::Part::State); break;
     case json_target::info:
-      serializeInfo(lDoc); break;
+      stream->add(JsonStream::Part::Object, nullptr, serializeInfo); break;
     case json_target::nodes:
-      serializeNodes(lDoc); break;
-    case json_target::palettes:
-      serializePalettes(lDoc, request->hasParam(F("page")) ? request->getParam(F("page"))->value().toInt() : 0); break;
+      stream->add(JsonStream::Part::Nodes); break;
+    case json_target::palettes: // all palettes at once unless a page is requested
+      if (request->hasParam(F("page"))) stream->page = max(0L, request->getParam(F("page"))->value().toInt());
+      stream->add(JsonStream::Part::Palettes); break;
     case json_target::effects:
-      serializeModeNames(lDoc); break;
+      stream->add(JsonStream::Part::ModeNames); break;
     case json_target::fxdata:
-      serializeModeData(lDoc); break;
+      stream->add(JsonStream::Part::ModeData); break;
     case json_target::networks:
-      serializeNetworks(lDoc); break;
+      stream->add(JsonStream::Part::Object, nullptr, serializeNetworks); break;
     case json_target::config:
-      serializeConfig(lDoc); break;
+      stream->add(JsonStream::Part::Object, nullptr, serializeConfig); break;
+    case json_target::perf:
+      stream->add(JsonStream::Part::Object, nullptr, serializePerf); break;
     case json_target::state_info:
     case json_target::all:
-      JsonObject state = lDoc.createNestedObject("state");
-      serializeState(state);
-      JsonObject info = lDoc.createNestedObject("info");
-      serializeInfo(info);
+      stream->addText(PSTR("{\"state\":"));
+      stream->add(JsonStream::Part::State);
+      stream->addText(PSTR(",\"info\":"));
+      stream->add(JsonStream::Part::Object, nullptr, serializeInfo);
       if (subJson == json_target::all)
       {
-        JsonArray effects = lDoc.createNestedArray(F("effects"));
-        serializeModeNames(effects); // remove WLED-SR extensions from effect names
-        lDoc[F("palettes")] = serialized((const __FlashStringHelper*)JSON_palette_names);
+        stream->addText(PSTR(",\"effects\":"));
+        stream->add(JsonStream::Part::ModeNames); // remove WLED-SR extensions from effect names
+        stream->addText(PSTR(",\"palettes\":"));
+        stream->addText(JSON_palette_names);
       }
-      //lDoc["m"] = lDoc.memoryUsage(); // JSON buffer usage, for remote debugging
+      stream->addText(PSTR("}"));
   }
 
-  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for request: %d\n"), lDoc.memoryUsage(), subJson);
-
-  [[maybe_unused]] size_t len = response->setLength();
-  DEBUG_PRINTF_P(PSTR("JSON content length: %u\n"), len);
+  DEBUG_PRINTF_P(PSTR("JSON streaming response for request: %d\n"), subJson);
 
-  request->send(response);
+  request->send(request->beginChunkedResponse(FPSTR(CONTENT_TYPE_JSON), [stream](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+    return stream->fill(buffer, maxLen);
+  }));
 }
 
 #ifdef WLED_ENABLE_JSONLIVE
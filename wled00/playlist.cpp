@@ -171,6 +171,7 @@ void handlePlaylist() {
     strip.setTransition(playlistEntries[playlistIndex].tr * 100);
     playlistEntryDur = playlistEntries[playlistIndex].dur > 0 ? playlistEntries[playlistIndex].dur : UINT16_MAX;
     applyPresetFromPlaylist(playlistEntries[playlistIndex].preset);
+    prefetchPreset(playlistEntries[(playlistIndex + 1) % playlistLen].preset); // so the next switch needs no file access
     doAdvancePlaylist = false;
   }
 }
@@ -15,6 +15,7 @@ static volatile int8_t saveLedmap = -1;
 static char *quickLoad = nullptr;
 static char *saveName = nullptr;
 static bool includeBri = true, segBounds = true, selectedOnly = false, playlistSave = false;;
+static volatile byte presetToPrefetch = 0;
 
 static const char presets_json[] PROGMEM = "/presets.json";
 static const char tmp_json[] PROGMEM = "/tmp.json";
@@ -87,6 +88,113 @@ static void doSaveState() {
   playlistSave = false;
 }
 
+/*
+ * Preset cache
+ * Presets applied from presets.json are kept in a small LRU cache, MessagePack encoded (ArduinoJson's
+ * compact binary form of the same document), and so is the next preset of a running playlist, which
+ * is read ahead while the current one is shown. A cached preset is decoded into pDoc without touching
+ * the file system and without waiting for the strip update that only protects file access, so playlist
+ * and DMX preset switches are not held up by a flash read and JSON parse.
+ * Entries are dropped when their preset is written and all of them when presets.json changes otherwise.
+ * All access happens with the JSON buffer lock held, except invalidatePresetCache(0) which only marks
+ * the entries stale (it is called on upload) so they are dropped with the next lookup.
+ */
+typedef struct PresetCacheEntry {
+  uint8_t  *data;     // MessagePack, nullptr if the entry is free
+  uint16_t  size;
+  byte      id;
+  uint32_t  lastUsed; // for LRU eviction
+} preset_cache_entry_t;
+
+static preset_cache_entry_t presetCache[WLED_PRESET_CACHE_ENTRIES];
+static size_t        presetCacheBytes = 0;
+static uint32_t      presetCacheUse = 0;
+static unsigned long presetCacheTime = 0; // presetsModifiedTime the entries are valid for
+static volatile bool presetCacheStale = false;
+
+// index 0 drops all entries
+static void dropCachedPresets(byte index) {
+  for (auto &e : presetCache) {
+    if (!e.data || (index && e.id != index)) continue;
+    free(e.data);
+    presetCacheBytes -= e.size;
+    e = {};
+  }
+}
+
+// index 0 drops all entries (with the next lookup)
+void invalidatePresetCache(byte index) {
+  if (index == 0) presetCacheStale = true;
+  else            dropCachedPresets(index);
+}
+
+static preset_cache_entry_t *findCachedPreset(byte index) {
+  if (presetCacheStale || presetCacheTime != presetsModifiedTime) { // presets.json was changed (saved, uploaded)
+    presetCacheStale = false;
+    dropCachedPresets(0);
+    presetCacheTime = presetsModifiedTime;
+  }
+  for (auto &e : presetCache) if (e.data && e.id == index) return &e;
+  return nullptr;
+}
+
+static bool readCachedPreset(byte index, JsonDocument *doc) {
+  preset_cache_entry_t *e = findCachedPreset(index);
+  if (!e || deserializeMsgPack(*doc, (const char*)e->data, e->size)) return false; // const input: strings are copied into doc
+  e->lastUsed = ++presetCacheUse;
+  return true;
+}
+
+// stores the preset in doc (as read from presets.json), evicting the least recently used entries to make room
+static void cachePreset(byte index, const JsonDocument *doc) {
+  if (index == 0 || index > 250 || findCachedPreset(index)) return;
+  size_t size = measureMsgPack(*doc);
+  if (size == 0 || size > WLED_PRESET_CACHE_BYTES) return;
+
+  preset_cache_entry_t *slot;
+  for (;;) {
+    preset_cache_entry_t *lru = nullptr;
+    slot = nullptr;
+    for (auto &e : presetCache) {
+      if (!e.data) { if (!slot) slot = &e; }
+      else if (!lru || e.lastUsed < lru->lastUsed) lru = &e;
+    }
+    if (slot && presetCacheBytes + size <= WLED_PRESET_CACHE_BYTES) break;
+    if (!lru) return;
+    dropCachedPresets(lru->id);
+  }
+
+  uint8_t *data;
+  #if defined(ARDUINO_ARCH_ESP32)
+  if (psramSafe && psramFound()) data = (uint8_t*) ps_malloc(size);
+  else
+  #endif
+  data = (uint8_t*) malloc(size);
+  if (!data) return;
+  serializeMsgPack(*doc, data, size);
+  *slot = {data, (uint16_t)size, index, ++presetCacheUse};
+  presetCacheBytes += size;
+}
+
+// reads a preset into the cache ahead of its use (done from handlePresets() when idle)
+void prefetchPreset(byte index) {
+  if (index > 0 && index <= 250) presetToPrefetch = index;
+}
+
+static void doPrefetchPreset() {
+  byte index = presetToPrefetch;
+  if (!requestJSONBufferLock(24)) return; // try again on the next loop
+  presetToPrefetch = 0;
+  if (!findCachedPreset(index)) {
+    #if defined(ARDUINO_ARCH_ESP32S3) || defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
+    unsigned long start = millis();
+    while (strip.isUpdating() && millis() - start < FRAMETIME_FIXED) yield(); // accessing FS during sendout causes glitches
+    #endif
+    if (readObjectFromFileUsingId(getPresetsFileName(), index, pDoc)) cachePreset(index, pDoc);
+  }
+  releaseJSONBufferLock();
+}
+
 bool getPresetName(byte index, String& name)
 {
   if (!requestJSONBufferLock(19)) return false;
@@ -155,7 +263,12 @@ void handlePresets()
     return;
   }
 
-  if (presetToApply == 0 || !requestJSONBufferLock(9)) return; // no preset waiting to apply, or JSON buffer is already allocated, return to loop until free
+  if (presetToApply == 0) {
+    if (presetToPrefetch) doPrefetchPreset();
+    else if (!foldJournal()) compactPresetsFile(); // only if due, when no preset is being applied or saved
+    return;
+  }
+  if (!requestJSONBufferLock(9)) return; // JSON buffer is already allocated, return to loop until free
 
   bool changePreset = false;
   uint8_t tmpPreset = presetToApply; // store temporary since deserializeState() may call applyPreset()
@@ -168,18 +281,21 @@ void handlePresets()
 
   DEBUG_PRINTF_P(PSTR("Applying preset: %u\n"), (unsigned)tmpPreset);
 
-  #if defined(ARDUINO_ARCH_ESP32S3) || defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
-  unsigned long start = millis();
-  while (strip.isUpdating() && millis() - start < FRAMETIME_FIXED) yield(); // wait for strip to finish updating, accessing FS during sendout causes glitches
-  #endif
-
-  #ifdef ARDUINO_ARCH_ESP32
-  if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
-    deserializeJson(*pDoc,tmpRAMbuffer);
-  } else
-  #endif
-  {
-  presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+  if (!readCachedPreset(tmpPreset, pDoc)) {
+    #if defined(ARDUINO_ARCH_ESP32S3) || defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
+    unsigned long start = millis();
+    while (strip.isUpdating() && millis() - start < FRAMETIME_FIXED) yield(); // wait for strip to finish updating, accessing FS during sendout causes glitches
+    #endif
+
+    #ifdef ARDUINO_ARCH_ESP32
+    if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
+      deserializeJson(*pDoc,tmpRAMbuffer);
+    } else
+    #endif
+    {
+    presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+    if (presetErrFlag == ERR_NONE) cachePreset(tmpPreset, pDoc); // before deserializeState() modifies it
+    }
   }
   fdo = pDoc->as<JsonObject>();
 
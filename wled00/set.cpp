@@ -152,7 +152,13 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     Bus::setCCTBlend(request->arg(F("CB")).toInt());
     Bus::setGlobalAWMode(request->arg(F("AW")).toInt());
     strip.setTargetFps(request->arg(F("FR")).toInt());
+    BusManager::setKeepAlive(request->arg(F("KA")).toInt());
+    t = request->arg(F("NP")).toInt();
+    if (t >= 0 && t <= 200) e131OutPriority = t;
+    t = request->arg(F("NY")).toInt();
+    if (t >= 0 && t <= 63999) e131OutSyncUniverse = t;
     useGlobalLedBuffer = request->hasArg(F("LD"));
+    useSegmentBuffers = request->hasArg(F("SB"));
     #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
     useParallelI2S = request->hasArg(F("PR"));
     #endif
@@ -173,6 +179,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       char sp[4] = "SP"; sp[2] = offset+s; sp[3] = 0; //bus clock speed (DotStar & PWM)
       char la[4] = "LA"; la[2] = offset+s; la[3] = 0; //LED mA
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max mA
+      char nu[4] = "NU"; nu[2] = offset+s; nu[3] = 0; //E1.31 start universe
       if (!request->hasArg(lp)) {
         DEBUG_PRINTF_P(PSTR("# of buses: %d\n"), s+1);
         break;
@@ -222,10 +229,12 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
         maPerLed = request->arg(la).toInt();
         maMax = request->arg(ma).toInt(); // if ABL is disabled this will be 0
       }
+      uint16_t universe = request->arg(nu).toInt();
+      if (universe == 0 || universe > 63999) universe = 1;
       type |= request->hasArg(rf) << 7; // off refresh override
       // actual finalization is done in WLED::loop() (removing old busses and adding new)
       // this may happen even before this loop is finished so we do "doInitBusses" after the loop
-      busConfigs.emplace_back(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freq, useGlobalLedBuffer, maPerLed, maMax);
+      busConfigs.emplace_back(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freq, useGlobalLedBuffer, maPerLed, maMax, universe);
       busesChanged = true;
     }
     //doInitBusses = busesChanged; // we will do that below to ensure all input data is processed
@@ -370,6 +379,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     simplifiedUI = request->hasArg(F("SU"));
     DEBUG_PRINTLN(F("Enumerating ledmaps"));
     enumerateLedmaps();
+    strip.invalidateLedmapCache(); // ledmap files may have been edited
     DEBUG_PRINTLN(F("Loading custom palettes"));
     strip.loadCustomPalettes(); // (re)load all custom palettes
   }
@@ -409,6 +419,10 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     if (!nodeListEnabled) Nodes.clear();
     nodeBroadcastEnabled = request->hasArg(F("NB"));
 
+    clockSync = request->hasArg(F("CK"));
+    t = request->arg(F("CY")).toInt();
+    if (t >= 0 && t <= 255) clockSyncPriority = t;
+
     receiveDirect = request->hasArg(F("RD")); // UDP realtime
     useMainSegmentOnly = request->hasArg(F("MO"));
     realtimeRespectLedMaps = request->hasArg(F("RLM"));
@@ -418,6 +432,8 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     if (t > 0) e131Port = t;
     t = request->arg(F("EU")).toInt();
     if (t >= 0  && t <= 63999) e131Universe = t;
+    t = request->arg(F("EF")).toInt();
+    if (t >= 0  && t <= 1000) e131FrameTimeout = t;
     t = request->arg(F("DA")).toInt();
     if (t >= 0  && t <= 510) DMXAddress = t;
     t = request->arg(F("XX")).toInt();
@@ -91,6 +91,16 @@ bool ESPAsyncE131::initMulticast(uint16_t port, uint16_t universe, uint8_t n) {
   return success;
 }
 
+void ESPAsyncE131::joinUniverse(uint16_t universe) {
+  ip4_addr_t ifaddr;
+  ip4_addr_t multicast_addr;
+
+  ifaddr.addr = static_cast<uint32_t>(Network.localIP());
+  multicast_addr.addr = static_cast<uint32_t>(IPAddress(239, 255,
+    ((universe >> 8) & 0xff), ((universe >> 0) & 0xff)));
+  igmp_joingroup(&ifaddr, &multicast_addr);
+}
+
 /////////////////////////////////////////////////////////
 //
 // Packet parsing - Private
@@ -110,8 +120,11 @@ void ESPAsyncE131::parsePacket(AsyncUDPPacket _packet) {
 	if (protocol == P_ARTNET) {
 		if (memcmp(sbuff->art_id, ESPAsyncE131::ART_ID, sizeof(sbuff->art_id)))
 			error = true; //not "Art-Net"
-		if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL)
-			error = true; //not a DMX or poll packet
+		if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL && sbuff->art_opcode != ARTNET_OPCODE_OPSYNC)
+			error = true; //not a DMX, poll or sync packet
+	} else if (htonl(sbuff->root_vector) == ESPAsyncE131::VECTOR_ROOT_EXTENDED) { //E1.31 synchronization packet
+		if (htonl(sbuff->sync_vector) != ESPAsyncE131::VECTOR_FRAME_SYNC)
+			error = true; //universe discovery is not supported
 	} else { //E1.31 error handling
 		if (htonl(sbuff->root_vector) != ESPAsyncE131::VECTOR_ROOT)
 			error = true;
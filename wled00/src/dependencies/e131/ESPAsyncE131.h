@@ -59,6 +59,7 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
 
 #define P_E131   0
 #define P_ARTNET 1
@@ -105,7 +106,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t sync_address;   // E1.31-2016 synchronization universe (0 = not synchronized)
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -132,6 +133,15 @@ typedef union {
     uint8_t  art_data[512];
   } __attribute__((packed));
 
+  struct { //E1.31 synchronization packet (root_vector is VECTOR_ROOT_EXTENDED)
+    uint8_t  sync_root[38];   // root layer as above
+    uint16_t sync_flength;
+    uint32_t sync_vector;
+    uint8_t  sync_sequence_number;
+    uint16_t sync_universe;
+    uint16_t sync_reserved;
+  } __attribute__((packed));
+
   struct { //DDP Header
     uint8_t flags;
     uint8_t sequenceNum;
@@ -222,10 +232,16 @@ class ESPAsyncE131 {
     e131_packet_callback_function _callback = nullptr;
 
  public:
+    // E1.31-2016 synchronization packets, handed to the callback like data packets
+    static const uint32_t VECTOR_ROOT_EXTENDED = 8;
+    static const uint32_t VECTOR_FRAME_SYNC = 1;
+
     ESPAsyncE131(e131_packet_callback_function callback);
 
     // Generic UDP listener, no physical or IP configuration
     bool begin(bool multicast, uint16_t port = E131_DEFAULT_PORT, uint16_t universe = 1, uint8_t n = 1);
+    // Join the multicast group of one more universe (i.e. an E1.31 synchronization universe)
+    void joinUniverse(uint16_t universe);
 };
 
 // Class to track e131 package priority
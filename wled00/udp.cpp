@@ -73,8 +73,8 @@ void notify(byte callMode, bool followUp)
   udpOut[22] = B(col);
   udpOut[23] = W(col);
 
-  udpOut[24] = followUp;
-  uint32_t t = millis() + strip.timebase;
+  udpOut[24] = followUp | (strip.clockLocked << 1); // bit 1: time below is on the synchronised network clock
+  uint32_t t = strip.clockMillis() + strip.timebase;
   udpOut[25] = (t >> 24) & 0xFF;
   udpOut[26] = (t >> 16) & 0xFF;
   udpOut[27] = (t >>  8) & 0xFF;
@@ -368,10 +368,12 @@ static void parseNotifyPacket(const uint8_t *udpIn) {
     stateChanged = true;
   }
 
+  // both clocks synchronised: the sender's time needs no network delay correction
+  bool clocksLocked = version > 5 && strip.clockLocked && (udpIn[24] & 0x02);
   if (applyEffects && version > 5) {
     uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
-    t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
-    t -= millis();
+    if (!clocksLocked) t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
+    t -= strip.clockMillis();
     strip.timebase = t;
     timebaseUpdated = true;
   }
@@ -387,7 +389,7 @@ static void parseNotifyPacket(const uint8_t *udpIn) {
       if (udpIn[29] > 99) ts = TOKI_TS_UDP_NTP;
       else if (udpIn[29] >= TOKI_TS_SEC) ts = TOKI_TS_UDP_SEC;
       toki.setTime(tm, ts);
-    } else if (timebaseUpdated && toki.getTimeSource() > 99) { //if we both have good times, get a more accurate timebase
+    } else if (timebaseUpdated && !clocksLocked && toki.getTimeSource() > 99) { //if we both have good times, get a more accurate timebase
       Toki::Time myTime = toki.getTime();
       uint32_t diff = toki.msDifference(tm, myTime);
       strip.timebase -= PRESUMED_NETWORK_DELAY; //no need to presume, use difference between NTP times at send and receive points
@@ -458,6 +460,48 @@ void exitRealtime() {
   updateInterfaces(CALL_MODE_WS_SEND);
 }
 
+#ifdef WLED_ENABLE_RT_LATENCY
+// Realtime latency tracing: every realtime path marks when the first packet of a frame arrived
+// and when the frame is complete, show() reports when the frame reached the busses.
+#define RT_LATENCY_STALE_US 1000000 // a frame that never completed (ignored data) does not hold its start longer
+
+static rt_latency_t  rtLatency;
+static unsigned long rtFrameRx = 0;   // first packet of the frame being received
+static unsigned long rtReadyRx = 0;   // first packet of the frame waiting for show()
+static unsigned long rtReadyTime = 0; // frame waiting for show() complete
+static bool rtReceiving = false;
+static bool rtReady = false;
+
+void realtimeLatencyReceived(unsigned long us) {
+  if (rtReceiving && us - rtFrameRx < RT_LATENCY_STALE_US) return;
+  rtFrameRx = us;
+  rtReceiving = true;
+}
+
+void realtimeLatencyReady() {
+  if (!rtReceiving) return;
+  rtReceiving = false;
+  if (rtReady) { // previous frame not shown yet, both go out with the next show() measured from the older one
+    rtLatency.merged++;
+    return;
+  }
+  rtReadyRx = rtFrameRx;
+  rtReadyTime = micros();
+  rtReady = true;
+}
+
+// called by WS2812FX::show()
+void realtimeLatencyShown(unsigned long showStart, unsigned long showEnd) {
+  if (!rtReady || long(showStart - rtReadyTime) < 0) return; // completed while show() was running, goes out with the next one
+  rtReady = false;
+  unsigned i = rtLatency.count++ % RT_LATENCY_SAMPLES;
+  rtLatency.ingest[i] = rtReadyTime - rtReadyRx;
+  rtLatency.wait[i]   = showStart - rtReadyTime;
+  rtLatency.bus[i]    = showEnd - showStart;
+}
+
+const rt_latency_t& getRealtimeLatency() { return rtLatency; }
+#endif
 
 #define TMP2NET_OUT_PORT 65442
 
@@ -478,6 +522,7 @@ void handleNotifications()
     notify(notificationSentCallMode,true);
   }
 
+  handleE131FrameTimeout();
   if (e131NewData && millis() - strip.getLastShow() > 15)
   {
     e131NewData = false;
@@ -505,6 +550,7 @@ void handleNotifications()
       if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return;
       realtimeIP = rgbUdp.remoteIP();
       DEBUG_PRINTLN(rgbUdp.remoteIP());
+      realtimeLatencyReceived(micros());
       uint8_t lbuf[packetSize];
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
@@ -514,6 +560,7 @@ void handleNotifications()
       for (size_t i = 0, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++) {
         setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
       }
+      realtimeLatencyReady();
       if (!(realtimeMode && useMainSegmentOnly)) strip.show();
       return;
     }
@@ -529,6 +576,12 @@ void handleNotifications()
   if (isSupp) len = notifier2Udp.read(udpIn, packetSize);
   else        len =  notifierUdp.read(udpIn, packetSize);
 
+  // network clock synchronisation
+  if (isSupp && udpIn[0] == CLOCK_SYNC_TOKEN) {
+    handleClockSyncPacket(udpIn, len, notifier2Udp.remoteIP());
+    return;
+  }
+
   // WLED nodes info notifications
   if (isSupp && udpIn[0] == 255 && udpIn[1] == 1 && len >= 40) {
     if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return;
@@ -581,6 +634,7 @@ void handleNotifications()
     }
     if (tpmType != 0xda) return; //return if notTPM2.NET data
 
+    realtimeLatencyReceived(micros());
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
     if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
@@ -591,13 +645,11 @@ void handleNotifications()
     byte numPackets = udpIn[5];
 
     unsigned id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-    unsigned totalLen = strip.getLengthTotal();
     if (useMainSegmentOnly) strip.getMainSegment().beginDraw(); // set up parameters for get/setPixelColor()
-    for (size_t i = 6; i < tpmPayloadFrameSize + 4U && id < totalLen; i += 3, id++) {
-      setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-    }
+    if (len > 6) setRealtimePixels(id, udpIn + 6, min((unsigned)tpmPayloadFrameSize, len - 6) / 3, 3);
     if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
       tpmPacketCount = 0;
+      realtimeLatencyReady();
       strip.show();
     }
     return;
@@ -615,11 +667,11 @@ void handleNotifications()
       realtimeTimeout = 0;
       return;
     } else {
+      realtimeLatencyReceived(micros());
       realtimeLock(udpIn[1]*1000 +1, REALTIME_MODE_UDP);
     }
     if (realtimeOverride && !(realtimeMode && useMainSegmentOnly)) return;
 
-    unsigned totalLen = strip.getLengthTotal();
     if (useMainSegmentOnly) strip.getMainSegment().beginDraw(); // set up parameters for get/setPixelColor()
     if (udpIn[0] == 1 && packetSize > 5) //warls
     {
@@ -629,31 +681,20 @@ void handleNotifications()
       }
     } else if (udpIn[0] == 2 && packetSize > 4) //drgb
     {
-      for (size_t i = 2, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 3, 3);
     } else if (udpIn[0] == 3 && packetSize > 6) //drgbw
     {
-      for (size_t i = 2, id = 0; i < packetSize -3 && id < totalLen; i += 4, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-      }
+      setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 4, 4);
     } else if (udpIn[0] == 4 && packetSize > 7) //dnrgb
     {
       unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 3, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 3, 3);
     } else if (udpIn[0] == 5 && packetSize > 8) //dnrgbw
     {
       unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 4, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-      }
+      setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 4, 4);
     }
+    realtimeLatencyReady();
     strip.show();
     return;
   }
@@ -695,6 +736,41 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   }
 }
 
+// setRealtimePixel() for count consecutive pixels of a packet with 3 (RGB) or 4 (RGBW) channels per pixel
+void setRealtimePixels(unsigned i, const uint8_t *data, unsigned count, unsigned channelsPerLed)
+{
+  if (useMainSegmentOnly) { // segment mapping, one pixel at a time
+    for (unsigned n = 0; n < count; n++, data += channelsPerLed)
+      setRealtimePixel(i + n, data[0], data[1], data[2], channelsPerLed > 3 ? data[3] : 0);
+    return;
+  }
+  int first = int(i) + arlsOffset;
+  if (first < 0) { // shifted off the start
+    if (unsigned(-first) >= count) return;
+    count -= -first;
+    data  += -first * channelsPerLed;
+    first  = 0;
+  }
+  unsigned pix = first;
+  const unsigned totalLen = strip.getLengthTotal();
+  if (pix >= totalLen) return;
+  if (count > totalLen - pix) count = totalLen - pix;
+
+  const bool gamma = !arlsDisableGammaCorrection && gammaCorrectCol;
+  uint32_t cols[64];
+  while (count > 0) {
+    unsigned n = min(count, (unsigned)(sizeof(cols)/sizeof(cols[0])));
+    for (unsigned k = 0; k < n; k++, data += channelsPerLed) {
+      byte w = channelsPerLed > 3 ? data[3] : 0;
+      if (gamma) cols[k] = RGBW32(gamma8(data[0]), gamma8(data[1]), gamma8(data[2]), gamma8(w));
+      else       cols[k] = RGBW32(data[0], data[1], data[2], w);
+    }
+    strip.setPixelColors(pix, cols, n);
+    pix   += n;
+    count -= n;
+  }
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -803,15 +879,90 @@ void sendSysInfoUDP()
 // length - the number of pixels
 // buffer - a buffer of at least length*4 bytes long
 // isRGBW - true if the buffer contains 4 components per pixel
+// startUniverse - E1.31 universe of the first pixels (busses sending to the same receivers need different ones)
 
 static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
 static const size_t ART_NET_HEADER_SIZE = 12;
 static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
 
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri, bool isRGBW)  {
+// optional gap between the packets of a frame, lets Wi-Fi drain instead of queuing a burst of packets
+#ifndef WLED_BROADCAST_PACING_US
+  #define WLED_BROADCAST_PACING_US 0
+#endif
+
+#define BROADCAST_PACKET_SIZE (DDP_HEADER_LEN + DDP_CHANNELS_PER_PACKET) // largest packet realtimeBroadcast() sends
+
+static WiFiUDP  broadcastUdp;               // kept open between frames
+static uint8_t *broadcastPacket = nullptr;  // packet being assembled, allocated on first use
+
+// E1.31 (sACN) output: root, framing and DMP layer are prepared once, data packets only fill in the per-universe fields
+#define E131_HEADER_SIZE      126 // up to and including the DMX start code
+#define E131_SYNC_PACKET_SIZE 49
+static const byte E131_ACN_ID[] PROGMEM = {0x41,0x53,0x43,0x2d,0x45,0x31,0x2e,0x31,0x37,0x00,0x00,0x00}; // "ASC-E1.17"
+
+static uint8_t *e131Header = nullptr;      // data packet header template
+static uint8_t  e131SyncSequence = 0;
+static std::map<uint16_t, uint8_t> e131OutSequence; // sequence number of each universe sent (receivers check it per universe)
+static bool     e131SyncMulticast = false; // a multicast E1.31 bus was sent since the last sync
+static std::vector<IPAddress> e131SyncClients; // unicast E1.31 receivers sent to since the last sync
+
+static inline bool isMulticast(IPAddress ip) { return ip[0] >= 224 && ip[0] <= 239; }
+static inline IPAddress e131MulticastAddress(uint16_t universe) { return IPAddress(239, 255, universe >> 8, universe & 0xFF); }
+
+static inline void putUint16(uint8_t *p, uint16_t v) { p[0] = v >> 8; p[1] = v; }
+
+// root layer shared by data and sync packets (CID derived from the MAC address)
+static void prepareE131Root(uint8_t *p, size_t packetSize, uint8_t vector) {
+  memset(p, 0, 38);
+  p[1] = 0x10;                                        // preamble size
+  memcpy_P(p + 4, E131_ACN_ID, sizeof(E131_ACN_ID));
+  putUint16(p + 16, 0x7000 | (packetSize - 16));      // flags & length
+  p[21] = vector;
+  memcpy_P(p + 22, PSTR("WLED"), 4);                  // CID: fixed prefix ...
+  WiFi.macAddress(p + 32);                            // ... and unique MAC
+}
+
+static bool prepareE131Header() {
+  if (!e131Header) {
+    e131Header = (uint8_t*)malloc(E131_HEADER_SIZE);
+    if (!e131Header) return false;
+  } else if (!strncmp((const char*)e131Header + 44, serverDescription, 63)) return true; // up to date
+  prepareE131Root(e131Header, E131_HEADER_SIZE + 512, 0x04); // length fields are set per packet
+  memset(e131Header + 38, 0, E131_HEADER_SIZE - 38);
+  e131Header[43] = 0x02;                              // framing vector: data packet
+  strncpy((char*)e131Header + 44, serverDescription, 63);
+  e131Header[117] = 0x02;                             // DMP vector: set property
+  e131Header[118] = 0xA1;                             // address & data type
+  e131Header[122] = 0x01;                             // address increment
+  return true;
+}
+
+// copies channel data into the packet payload, scaled by brightness (same result as scale8())
+static void packChannels(uint8_t *dst, const uint8_t *src, size_t len, uint8_t bri) {
+  if (bri == 255) {
+    memcpy(dst, src, len);
+    return;
+  }
+  const unsigned scale = 1 + bri;
+  for (size_t i = 0; i < len; i++) dst[i] = (src[i] * scale) >> 8;
+}
+
+static bool sendBroadcastPacket(IPAddress client, uint16_t port, size_t len, bool first) {
+  #if WLED_BROADCAST_PACING_US > 0
+  if (!first) delayMicroseconds(WLED_BROADCAST_PACING_US);
+  #endif
+  if (!broadcastUdp.beginPacket(client, port)) return false;
+  broadcastUdp.write(broadcastPacket, len);
+  return broadcastUdp.endPacket();
+}
+
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri, bool isRGBW, uint16_t startUniverse)  {
   if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
 
-  WiFiUDP ddpUdp;
+  if (!broadcastPacket) {
+    broadcastPacket = (uint8_t*)malloc(BROADCAST_PACKET_SIZE);
+    if (!broadcastPacket) return 1;
+  }
 
   switch (type) {
     case 0: // DDP
@@ -822,17 +973,14 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
 
       // there are 3 channels per RGB pixel
       uint32_t channel = 0; // TODO: allow specifying the start channel
-      // the current position in the buffer
-      size_t bufferOffset = 0;
+
+      // header fields that are the same for all packets
+      broadcastPacket[2] = isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+      broadcastPacket[3] = DDP_ID_DISPLAY;
 
       for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
         if (sequenceNumber > 15) sequenceNumber = 0;
 
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
-
         // the amount of data is AFTER the header in the current packet
         size_t packetSize = DDP_CHANNELS_PER_PACKET;
 
@@ -846,30 +994,19 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
           }
         }
 
-        // write the header
-        /*0*/ddpUdp.write(flags);
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
+        /*0*/broadcastPacket[0] = flags;
+        /*1*/broadcastPacket[1] = sequenceNumber++ & 0x0F; // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
         // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
+        /*4*/broadcastPacket[4] = 0xFF & (channel >> 24);
+        /*5*/broadcastPacket[5] = 0xFF & (channel >> 16);
+        /*6*/broadcastPacket[6] = 0xFF & (channel >>  8);
+        /*7*/broadcastPacket[7] = 0xFF & (channel      );
         // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+        /*8*/broadcastPacket[8] = 0xFF & (packetSize >> 8);
+        /*9*/broadcastPacket[9] = 0xFF & (packetSize     );
+        packChannels(broadcastPacket + DDP_HEADER_LEN, buffer + channel, packetSize, bri);
 
-        if (!ddpUdp.endPacket()) {
+        if (!sendBroadcastPacket(client, DDP_DEFAULT_PORT, DDP_HEADER_LEN + packetSize, currentPacket == 0)) {  // port defined in ESPAsyncE131.h
           //DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
           return 1; // problem
         }
@@ -880,6 +1017,52 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
 
     case 1: //E1.31
     {
+      if (!prepareE131Header()) return 1;
+      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
+      const size_t E131_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+      const size_t packetCount = ((channelCount-1)/E131_CHANNELS_PER_PACKET)+1;
+      const bool multicast = isMulticast(client);
+
+      uint32_t channel = 0;
+
+      // header fields that are the same for all packets
+      memcpy(broadcastPacket, e131Header, E131_HEADER_SIZE);
+      broadcastPacket[108] = e131OutPriority;
+      putUint16(broadcastPacket + 109, e131OutSyncUniverse);
+
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+
+        size_t packetSize = E131_CHANNELS_PER_PACKET;
+
+        if (currentPacket == (packetCount - 1U)) {
+          // last packet
+          if (channelCount % E131_CHANNELS_PER_PACKET) {
+            packetSize = channelCount % E131_CHANNELS_PER_PACKET;
+          }
+        }
+
+        const unsigned universe = startUniverse + currentPacket; // 1 full packet == 1 full universe
+        if (universe > 63999) break; // highest valid E1.31 universe
+        const size_t size = E131_HEADER_SIZE + packetSize;
+        putUint16(broadcastPacket +  16, 0x7000 | (size - 16));  // root layer flags & length
+        putUint16(broadcastPacket +  38, 0x7000 | (size - 38));  // framing layer flags & length
+        broadcastPacket[111] = ++e131OutSequence[universe];
+        putUint16(broadcastPacket + 113, universe);
+        putUint16(broadcastPacket + 115, 0x7000 | (size - 115)); // DMP layer flags & length
+        putUint16(broadcastPacket + 123, packetSize + 1);        // property value count, including start code
+        packChannels(broadcastPacket + E131_HEADER_SIZE, buffer + channel, packetSize, bri);
+
+        if (!sendBroadcastPacket(multicast ? e131MulticastAddress(universe) : client, E131_DEFAULT_PORT, size, currentPacket == 0)) {
+          DEBUG_PRINTLN(F("E1.31 WiFiUDP.endPacket returned an error"));
+          return 1; // borked
+        }
+        channel += packetSize;
+      }
+
+      if (e131OutSyncUniverse) { // remember where the sync packet has to go
+        if (multicast) e131SyncMulticast = true;
+        else if (std::find(e131SyncClients.begin(), e131SyncClients.end(), client) == e131SyncClients.end()) e131SyncClients.push_back(client);
+      }
     } break;
 
     case 2: //ArtNet
@@ -890,18 +1073,17 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
       const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
 
       uint32_t channel = 0; 
-      size_t bufferOffset = 0;
 
       sequenceNumber++;
+      if (sequenceNumber > 255) sequenceNumber = 0;
 
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-        if (sequenceNumber > 255) sequenceNumber = 0;
+      // header fields that are the same for all packets
+      memcpy_P(broadcastPacket, ART_NET_HEADER, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
+      broadcastPacket[12] = sequenceNumber & 0xFF; // sequence number. 1..255
+      broadcastPacket[13] = 0x00; // physical - more an FYI, not really used for anything. 0..3
+      broadcastPacket[15] = 0x00; // Universe MSB, unused.
 
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
 
         size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
 
@@ -912,24 +1094,12 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
           }
         }
 
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+        broadcastPacket[14] = (currentPacket) & 0xFF; // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
+        broadcastPacket[16] = 0xFF & (packetSize >> 8); // 16-bit length of channel data, MSB
+        broadcastPacket[17] = 0xFF & (packetSize     ); // 16-bit length of channel data, LSB
+        packChannels(broadcastPacket + ART_NET_HEADER_SIZE + 6, buffer + channel, packetSize, bri);
 
-        if (!ddpUdp.endPacket()) {
+        if (!sendBroadcastPacket(client, ARTNET_DEFAULT_PORT, ART_NET_HEADER_SIZE + 6 + packetSize, currentPacket == 0)) {
           DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
           return 1; // borked
         }
@@ -940,6 +1110,23 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
   return 0;
 }
 
+// sends the E1.31 sync packet for the E1.31 network busses sent since the last call, receivers then show their frame
+void realtimeBroadcastSync() {
+  if (!e131SyncMulticast && e131SyncClients.empty()) return;
+  if (e131OutSyncUniverse && broadcastPacket) {
+    prepareE131Root(broadcastPacket, E131_SYNC_PACKET_SIZE, 0x08);
+    putUint16(broadcastPacket + 38, 0x7000 | (E131_SYNC_PACKET_SIZE - 38));
+    memset(broadcastPacket + 40, 0, E131_SYNC_PACKET_SIZE - 40);
+    broadcastPacket[43] = 0x01;                          // framing vector: synchronization
+    broadcastPacket[44] = e131SyncSequence++;
+    putUint16(broadcastPacket + 45, e131OutSyncUniverse);
+    if (e131SyncMulticast) sendBroadcastPacket(e131MulticastAddress(e131OutSyncUniverse), E131_DEFAULT_PORT, E131_SYNC_PACKET_SIZE, true);
+    for (const IPAddress &client : e131SyncClients) sendBroadcastPacket(client, E131_DEFAULT_PORT, E131_SYNC_PACKET_SIZE, true);
+  }
+  e131SyncMulticast = false;
+  e131SyncClients.clear();
+}
+
 #ifndef WLED_DISABLE_ESPNOW
 // ESP-NOW message sent callback function
 void espNowSentCB(uint8_t* address, uint8_t status) {
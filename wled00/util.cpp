@@ -162,7 +162,7 @@ bool requestJSONBufferLock(uint8_t moduleID)
   // Use a recursive mutex type in case our task is the one holding the JSON buffer.
   // This can happen during large JSON web transactions.  In this case, we continue immediately
   // and then will return out below if the lock is still held.
-  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) return false;  // timed out waiting
+  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) { jsonBufferRejected++; return false; }  // timed out waiting
 #elif defined(ARDUINO_ARCH_ESP8266)
   // If we're in system context, delay() won't return control to the user context, so there's
   // no point in waiting.
@@ -176,6 +176,7 @@ bool requestJSONBufferLock(uint8_t moduleID)
   // If the lock is still held - by us, or by another task
   if (jsonBufferLock) {
     DEBUG_PRINTF_P(PSTR("ERROR: Locking JSON buffer (%d) failed! (still locked by %d)\n"), moduleID, jsonBufferLock);
+    jsonBufferRejected++;
 #ifdef ARDUINO_ARCH_ESP32
     xSemaphoreGiveRecursive(jsonBufferLockMutex);
 #endif
@@ -199,6 +200,99 @@ void releaseJSONBufferLock()
 }
 
 
+// JSON document pool for read-only responses (/json GET, WebSocket state pushes).
+// A response holds its document until the client has received all of it, which with the
+// global buffer blocked every other API user for as long as a slow client took. Documents
+// are allocated on first use (in PSRAM if available) and kept for reuse, as long as enough
+// memory stays free. State is still read under the JSON buffer lock (state changes hold it
+// while segments may be reallocated), but only while it is serialized into the document:
+// unlockJSONDocument() releases it before the document is sent.
+static PSRAMDynamicJsonDocument *jsonPool[WLED_JSON_POOL_SIZE] = {nullptr};
+static bool          jsonPoolInUse[WLED_JSON_POOL_SIZE] = {false};
+static JsonDocument *jsonPoolLockHolder = nullptr; // pool document holding the JSON buffer lock
+
+static bool jsonPoolMemoryAvailable()
+{
+#if defined(ARDUINO_ARCH_ESP32)
+  if (psramSafe && psramFound()) return ESP.getFreePsram() > JSON_BUFFER_SIZE + JSON_POOL_HEAP_RESERVE;
+  return ESP.getFreeHeap() > JSON_BUFFER_SIZE + JSON_POOL_HEAP_RESERVE && ESP.getMaxAllocHeap() > JSON_BUFFER_SIZE;
+#else
+  return ESP.getFreeHeap() > JSON_BUFFER_SIZE + JSON_POOL_HEAP_RESERVE && ESP.getMaxFreeBlockSize() > JSON_BUFFER_SIZE;
+#endif
+}
+
+// returns a cleared document from the pool, or pDoc if the pool is exhausted, with the buffer lock
+// held in both cases; nullptr if the lock or a document is not available.
+// Call unlockJSONDocument() once the state is serialized and releaseJSONDocument() when done.
+JsonDocument* requestJSONDocument(uint8_t moduleID)
+{
+  if (!requestJSONBufferLock(moduleID)) return nullptr;
+  int slot = -1;
+#ifdef ARDUINO_ARCH_ESP32
+  xSemaphoreTake(jsonPoolMutex, portMAX_DELAY);
+#endif
+  for (int i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (jsonPoolInUse[i]) continue;
+    if (jsonPool[i]) { slot = i; break; } // prefer documents already allocated
+    if (slot < 0) slot = i;
+  }
+  if (slot >= 0) jsonPoolInUse[slot] = true;
+#ifdef ARDUINO_ARCH_ESP32
+  xSemaphoreGive(jsonPoolMutex);
+#endif
+
+  if (slot >= 0) {
+    if (!jsonPool[slot] && jsonPoolMemoryAvailable()) {
+      jsonPool[slot] = new PSRAMDynamicJsonDocument(JSON_BUFFER_SIZE);
+      if (jsonPool[slot] && jsonPool[slot]->capacity() == 0) { delete jsonPool[slot]; jsonPool[slot] = nullptr; } // allocation failed
+      DEBUG_PRINTF_P(PSTR("JSON pool document %d %s.\n"), slot, jsonPool[slot] ? "allocated" : "allocation failed");
+    }
+    if (jsonPool[slot]) {
+      jsonPool[slot]->clear();
+      jsonPoolLockHolder = jsonPool[slot];
+      return jsonPool[slot];
+    }
+    jsonPoolInUse[slot] = false;
+  }
+  return pDoc;
+}
+
+// releases the buffer lock held for a pool document (pDoc stays locked until releaseJSONDocument())
+void unlockJSONDocument(JsonDocument *doc)
+{
+  if (doc == nullptr || doc != jsonPoolLockHolder) return;
+  jsonPoolLockHolder = nullptr;
+  releaseJSONBufferLock();
+}
+
+void releaseJSONDocument(JsonDocument *doc)
+{
+  if (doc == nullptr) return;
+  if (doc == pDoc) { releaseJSONBufferLock(); return; }
+  unlockJSONDocument(doc);
+  for (int i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (jsonPool[i] != doc) continue;
+    doc->clear();
+    bool keep = ESP.getFreeHeap() >= JSON_POOL_HEAP_RESERVE; // give heap back while it is short
+#if defined(ARDUINO_ARCH_ESP32)
+    keep |= psramSafe && psramFound();
+#endif
+    if (!keep) { delete jsonPool[i]; jsonPool[i] = nullptr; }
+    jsonPoolInUse[i] = false;
+    return;
+  }
+}
+
+void getJSONPoolUsage(uint8_t &allocated, uint8_t &inUse)
+{
+  allocated = inUse = 0;
+  for (int i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (jsonPool[i])       allocated++;
+    if (jsonPoolInUse[i])  inUse++;
+  }
+}
+
+
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (including SR extensions)!
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen)
@@ -528,7 +622,8 @@ um_data_t* simulateSound(uint8_t simulationId)
 }
 
 static const char s_ledmap_tmpl[] PROGMEM = "ledmap%d.json";
-// enumerate all ledmapX.json files on FS and extract ledmap names if existing
+static const char s_ledmap_bin_tmpl[] PROGMEM = "/ledmap%d.lmb";
+// enumerate all ledmapX.json (and binary ledmapX.lmb) files on FS and extract ledmap names if existing
 void enumerateLedmaps() {
   StaticJsonDocument<64> filter;
   filter["n"] = true;
@@ -537,6 +632,9 @@ void enumerateLedmaps() {
     char fileName[33] = "/";
     sprintf_P(fileName+1, s_ledmap_tmpl, i);
     bool isFile = WLED_FS.exists(fileName);
+    char binName[33];
+    sprintf_P(binName, s_ledmap_bin_tmpl, (int)i);
+    bool isBinary = WLED_FS.exists(binName);
 
     #ifndef ESP8266
     if (ledmapNames[i-1]) { //clear old name
@@ -545,11 +643,17 @@ void enumerateLedmaps() {
     }
     #endif
 
-    if (isFile) {
+    if (isFile || isBinary) {
       ledMaps |= 1 << i;
 
       #ifndef ESP8266
-      if (requestJSONBufferLock(21)) {
+      char tmp[33];
+      if (isBinary) { // binary ledmaps take precedence and carry their name in the header
+        if (strip.getBinaryLedmapName(i, tmp, sizeof(tmp)) && tmp[0]) {
+          ledmapNames[i-1] = static_cast<char*>(malloc(strlen(tmp)+1));
+          if (ledmapNames[i-1]) strcpy(ledmapNames[i-1], tmp);
+        }
+      } else if (requestJSONBufferLock(21)) {
         if (readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
           size_t len = 0;
           JsonObject root = pDoc->as<JsonObject>();
@@ -562,16 +666,15 @@ void enumerateLedmaps() {
               if (ledmapNames[i-1]) strlcpy(ledmapNames[i-1], name, 33);
             }
           }
-          if (!ledmapNames[i-1]) {
-            char tmp[33];
-            snprintf_P(tmp, 32, s_ledmap_tmpl, i);
-            len = strlen(tmp);
-            ledmapNames[i-1] = static_cast<char*>(malloc(len+1));
-            if (ledmapNames[i-1]) strlcpy(ledmapNames[i-1], tmp, 33);
-          }
         }
         releaseJSONBufferLock();
       }
+      if (!ledmapNames[i-1]) {
+        snprintf_P(tmp, 32, s_ledmap_tmpl, i);
+        size_t len = strlen(tmp);
+        ledmapNames[i-1] = static_cast<char*>(malloc(len+1));
+        if (ledmapNames[i-1]) strlcpy(ledmapNames[i-1], tmp, 33);
+      }
       #endif
     }
 
@@ -30,6 +30,7 @@ void WLED::reset()
     yield();        // enough time to send response to client
   }
   applyBri();
+  foldJournal(true); // pending settings and presets would otherwise be replayed at boot
   DEBUG_PRINTLN(F("WLED RESET"));
   ESP.restart();
 }
@@ -63,6 +64,7 @@ void WLED::loop()
   #endif
   handleImprovWifiScan();
   handleNotifications();
+  handleClockSync();
   handleTransitions();
   #ifdef WLED_ENABLE_DMX
   handleDMXOutput();
@@ -406,9 +408,12 @@ void WLED::setup()
   if (!fsinit) {
     DEBUGFS_PRINTLN(F("FS failed!"));
     errorFlag = ERR_FS_BEGIN;
+  } else {
+    initPresetIndex(); // finishes an interrupted compaction of presets.json before it may be created anew
+    initJournal();     // replays records a reset or power loss left in the journal before settings are read
   }
 #ifdef WLED_ADD_EEPROM_SUPPORT
-  else deEEP();
+  if (fsinit) deEEP();
 #else
   initPresetsFile();
 #endif
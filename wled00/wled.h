@@ -35,6 +35,7 @@
   #undef WLED_ENABLE_ADALIGHT      // disable has priority over enable
 #endif
 //#define WLED_ENABLE_DMX          // uses 3.5kb
+//#define WLED_ENABLE_RT_LATENCY   // realtime packet-to-photon latency tracing, reported in /json/perf ("rt") and over WebSocket ({"rtl":true})
 #ifndef WLED_DISABLE_LOXONE
   #define WLED_ENABLE_LOXONE       // uses 1.2kb
 #endif
@@ -410,6 +411,7 @@ WLED_GLOBAL bool useGlobalLedBuffer _INIT(true);  // double buffering enabled on
 WLED_GLOBAL bool useParallelI2S     _INIT(false); // parallel I2S for ESP32
   #endif
 #endif
+WLED_GLOBAL bool useSegmentBuffers  _INIT(false); // segments render into own buffers which are composited (blend modes)
 #ifdef WLED_USE_IC_CCT
 WLED_GLOBAL bool cctICused          _INIT(true);  // CCT IC used (Athom 15W bulbs)
 #else
@@ -441,6 +443,8 @@ WLED_GLOBAL byte cacheInvalidate       _INIT(0);       // used to invalidate bro
 WLED_GLOBAL NodesMap Nodes;
 WLED_GLOBAL bool nodeListEnabled _INIT(true);
 WLED_GLOBAL bool nodeBroadcastEnabled _INIT(true);
+WLED_GLOBAL bool clockSync _INIT(false);          // synchronise the effect clock with other nodes
+WLED_GLOBAL byte clockSyncPriority _INIT(128);    // clock sync master election, lowest value (then lowest IP) wins
 
 #ifndef WLED_DISABLE_INFRARED
 WLED_GLOBAL int8_t irPin        _INIT(IRPIN);
@@ -492,6 +496,9 @@ WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of v
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL byte e131OutPriority _INIT(100);                      // priority of E1.31 network bus output
+WLED_GLOBAL uint16_t e131OutSyncUniverse _INIT(0);                // E1.31 network bus output: synchronization universe (0 = unsynchronized)
+WLED_GLOBAL uint16_t e131FrameTimeout _INIT(100);                 // ms a multi-universe frame waits for missing universes or sync (0 = show every universe)
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
 
 // mqtt
@@ -963,6 +970,10 @@ WLED_GLOBAL StaticJsonDocument<JSON_BUFFER_SIZE> gDoc;
 WLED_GLOBAL JsonDocument *pDoc _INIT(&gDoc);
 #endif
 WLED_GLOBAL volatile uint8_t jsonBufferLock _INIT(0);
+WLED_GLOBAL uint32_t jsonBufferRejected _INIT(0); // JSON requests that found no free buffer
+#if defined(ARDUINO_ARCH_ESP32)
+WLED_GLOBAL SemaphoreHandle_t jsonPoolMutex _INIT(xSemaphoreCreateMutex());
+#endif
 
 // enable additional debug output
 #if defined(WLED_DEBUG_HOST)
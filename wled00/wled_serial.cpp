@@ -84,8 +84,8 @@ void handleSerial()
     byte next = Serial.peek();
     switch (state) {
       case AdaState::Header_A:
-        if      (next == 'A')  { state = AdaState::Header_d; }
-        else if (next == 0xC9) { state = AdaState::TPM2_Header_Type; } //TPM2 start byte
+        if      (next == 'A')  { state = AdaState::Header_d; realtimeLatencyReceived(micros()); }
+        else if (next == 0xC9) { state = AdaState::TPM2_Header_Type; realtimeLatencyReceived(micros()); } //TPM2 start byte
         else if (next == 'I')  { handleImprovPacket(); return; }
         else if (next == 'v')  { Serial.print("WLED"); Serial.write(' '); Serial.println(VERSION); }
         else if (next == 0xB0) { updateBaudRate( 115200); }
@@ -176,7 +176,7 @@ void handleSerial()
         if (--count > 0) state = AdaState::Data_Red;
         else {
           realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
-
+          realtimeLatencyReady();
           if (!realtimeOverride) strip.show();
           state = AdaState::Header_A;
         }
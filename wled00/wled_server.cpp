@@ -163,20 +163,29 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
       finalname = '/' + finalname; // prepend slash if missing
     }
 
+    discardJournal(finalname.c_str()); // pending records would overwrite the uploaded file
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
-    if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
+    if (finalname.equals(FPSTR(getPresetsFileName()))) {
+      presetsModifiedTime = toki.second();
+      invalidatePresetIndex();
+      invalidatePresetCache(0); // presetsModifiedTime may not change within the same second
+    }
   }
   if (len) {
     request->_tempFile.write(data,len);
   }
   if (isFinal) {
     request->_tempFile.close();
+    String finalname = filename;
+    if (finalname.charAt(0) != '/') finalname = '/' + finalname;
+    if (finalname.equals(FPSTR(getPresetsFileName()))) invalidatePresetIndex(); // upload complete, presets.json may be compacted again
     if (filename.indexOf(F("cfg.json")) >= 0) { // check for filename with or without slash
       doReboot = true;
       request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("Configuration restore successful.\nRebooting..."));
     } else {
       if (filename.indexOf(F("palette")) >= 0 && filename.indexOf(F(".json")) >= 0) strip.loadCustomPalettes();
+      if (filename.indexOf(F("ledmap")) >= 0) strip.invalidateLedmapCache();
       request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("File Uploaded!"));
     }
     cacheInvalidate++;
@@ -5,11 +5,70 @@
  */
 #ifdef WLED_ENABLE_WEBSOCKETS
 
-uint16_t wsLiveClientId = 0;
-unsigned long wsLastLiveTime = 0;
+#define WS_LIVE_INTERVAL     40   // fastest live view frame rate (ms between frames)
+#define WS_LIVE_INTERVAL_MAX 1000 // slowest rate a client with a full queue is backed off to
+#ifdef ESP8266
+#define WS_MAX_LIVE_CLIENTS  1
+#define WS_LIVE_MAX_PIXELS   1024U // larger version 3 regions are cropped
+#else
+#define WS_MAX_LIVE_CLIENTS  4
+#define WS_LIVE_MAX_PIXELS   (unsigned)MAX_LEDS
+#endif
+
+unsigned long wsLastCleanup = 0;
+
+// live view subscribers
+// version 1/2 clients ({"lv":true}) get every n-th LED of the whole strip as raw RGB,
+// version 3 clients ({"lv":{}} or {"lv":{"roi":[x,y,w,h]}}) get full resolution frames of a region,
+// encoded against the previous frame sent to that client (see encodeLiveFrame())
+typedef struct LiveRegion {
+  uint16_t x, y, w, h;
+  bool operator==(const LiveRegion &o) const { return x == o.x && y == o.y && w == o.w && h == o.h; }
+} live_region_t;
+
+typedef struct LiveClient {
+  uint32_t id;            // WS client id, 0 = unused
+  live_region_t roi;      // requested region, w/h 0 = up to the end
+  live_region_t sent;     // region of prev
+  uint8_t *prev;          // region as last sent (RGB), only version 3
+  uint16_t interval;      // current time between frames (ms), backs off while the client's queue is full
+  unsigned long lastTime; // last frame sent
+  bool     delta;         // version 3 client
+} live_client_t;
+
+static live_client_t liveClients[WS_MAX_LIVE_CLIENTS];
+static uint8_t *liveScratch = nullptr; // encoded frame before it is copied into a WS buffer
+static size_t   liveScratchLen = 0;
+#ifdef WLED_ENABLE_RT_LATENCY
+uint16_t wsLatencyClientId = 0;
+unsigned long wsLastLatencyTime = 0;
+uint32_t wsLastLatencyCount = 0;
+#define WS_LATENCY_INTERVAL 1000
+#endif
 //uint8_t* wsFrameBuffer = nullptr;
 
-#define WS_LIVE_INTERVAL 40
+static void removeLiveClient(uint32_t id)
+{
+  for (live_client_t &lc : liveClients) if (lc.id == id) {
+    free(lc.prev);
+    lc = live_client_t{};
+  }
+}
+
+// (re)subscribe a client to live view; request is true/false or a version 3 object
+static void setLiveClient(uint32_t id, JsonVariant request)
+{
+  removeLiveClient(id);
+  if (!request.is<JsonObject>() && !request.as<bool>()) return;
+  for (live_client_t &lc : liveClients) if (!lc.id) {
+    lc.id = id;
+    lc.interval = WS_LIVE_INTERVAL;
+    lc.delta = request.is<JsonObject>();
+    JsonArray roi = request["roi"];
+    if (!roi.isNull()) lc.roi = {roi[0] | (uint16_t)0, roi[1] | (uint16_t)0, roi[2] | (uint16_t)0, roi[3] | (uint16_t)0};
+    return;
+  }
+}
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
@@ -19,7 +78,10 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
-    if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    removeLiveClient(client->id());
+    #ifdef WLED_ENABLE_RT_LATENCY
+    if (client->id() == wsLatencyClientId) wsLatencyClientId = 0;
+    #endif
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
@@ -51,7 +113,12 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           //if the received value is just "{"v":true}", send only to this client
           verboseResponse = true;
         } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
+          setLiveClient(client->id(), root["lv"]);
+        #ifdef WLED_ENABLE_RT_LATENCY
+        } else if (root.containsKey("rtl")) { // realtime latency percentiles once per second while frames arrive
+          wsLatencyClientId = root["rtl"] ? client->id() : 0;
+          wsLastLatencyCount = 0;
+        #endif
         } else {
           verboseResponse = deserializeState(root);
         }
@@ -105,7 +172,8 @@ void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
 
-  if (!requestJSONBufferLock(12)) {
+  JsonDocument *doc = requestJSONDocument(12);
+  if (!doc) {
     const char* error = PSTR("{\"error\":3}");
     if (client) {
       client->text(FPSTR(error)); // ERR_NOBUF
@@ -115,19 +183,21 @@ void sendDataWs(AsyncWebSocketClient * client)
     return;
   }
 
-  JsonObject state = pDoc->createNestedObject("state");
+  JsonObject state = doc->createNestedObject("state");
   serializeState(state);
-  JsonObject info  = pDoc->createNestedObject("info");
+  JsonObject info  = doc->createNestedObject("info");
   serializeInfo(info);
+  unlockJSONDocument(doc); // state is copied, let it change while the document is sent
 
-  size_t len = measureJson(*pDoc);
-  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), pDoc->memoryUsage(), len);
+  size_t len = measureJson(*doc);
+  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), doc->memoryUsage(), len);
 
   // the following may no longer be necessary as heap management has been fixed by @willmmiles in AWS
   size_t heap1 = ESP.getFreeHeap();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), ESP.getFreeHeap());
   #ifdef ESP8266
   if (len>heap1) {
+    releaseJSONDocument(doc);
     DEBUG_PRINTLN(F("Out of memory (WS)!"));
     return;
   }
@@ -140,13 +210,13 @@ void sendDataWs(AsyncWebSocketClient * client)
   size_t heap2 = 0; // ESP32 variants do not have the same issue and will work without checking heap allocation
   #endif
   if (!buffer || heap1-heap2<len) {
-    releaseJSONBufferLock();
+    releaseJSONDocument(doc);
     DEBUG_PRINTLN(F("WS buffer allocation failed."));
     ws.closeAll(1013); //code 1013 = temporary overload, try again later
     ws.cleanupClients(0); //disconnect all clients to release memory
     return; //out of memory
   }
-  serializeJson(*pDoc, (char *)buffer.data(), len);
+  serializeJson(*doc, (char *)buffer.data(), len);
 
   DEBUG_PRINT(F("Sending WS data "));
   if (client) {
@@ -157,14 +227,12 @@ void sendDataWs(AsyncWebSocketClient * client)
     ws.textAll(std::move(buffer));
   }
 
-  releaseJSONBufferLock();
+  releaseJSONDocument(doc);
 }
 
-bool sendLiveLedsWs(uint32_t wsClient)
+// version 1 (1D) / 2 (2D) frame: every n-th LED if there are more than MAX_LIVE_LEDS_WS
+static bool sendLiveLedsWs(AsyncWebSocketClient * wsc)
 {
-  AsyncWebSocketClient * wsc = ws.client(wsClient);
-  if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
-
   size_t used = strip.getLengthTotal();
 #ifdef ESP8266
   const size_t MAX_LIVE_LEDS_WS = 256U;
@@ -219,20 +287,179 @@ bool sendLiveLedsWs(uint32_t wsClient)
   return true;
 }
 
+// Version 3 frame records, each starts with a byte of 2 bit type and 6 bit count-1:
+//   0b00nnnnnn  n+1 pixels unchanged since the previous frame sent
+//   0b01nnnnnn  n+1 pixels of the 3 byte RGB color that follows
+//   0b10nnnnnn  n+1 RGB colors follow
+// prev (may be nullptr) holds the previous frame unless key is set and is updated to the current one.
+// Returns the encoded length, 0 if no pixel changed.
+static size_t encodeLiveFrame(uint8_t *out, uint8_t *prev, bool key, const live_region_t &r, bool matrix)
+{
+  enum : uint8_t { OP_SKIP = 0x00, OP_RUN = 0x40, OP_LIT = 0x80, OP_NONE = 0xFF };
+  size_t pos = 0, opPos = 0;
+  uint8_t op = OP_NONE;
+  unsigned count = 0;
+  uint32_t lastColor = 0;
+  bool changed = false;
+  auto flush = [&]() { if (op != OP_NONE) out[opPos] = op | (count - 1); op = OP_NONE; };
+  auto begin = [&](uint8_t newOp) { flush(); op = newOp; count = 1; opPos = pos++; };
+
+  for (unsigned y = r.y; y < r.y + r.h; y++) for (unsigned x = r.x; x < r.x + r.w; x++) {
+    uint32_t c = strip.getPixelColor(matrix ? y * Segment::maxWidth + x : x);
+    uint8_t red   = bri ? qadd8(W(c), R(c)) : 0; // add white channel to RGB channels as a simple RGBW -> RGB map
+    uint8_t green = bri ? qadd8(W(c), G(c)) : 0;
+    uint8_t blue  = bri ? qadd8(W(c), B(c)) : 0;
+    c = RGBW32(red, green, blue, 0);
+    bool unchanged = !key && prev && prev[0] == red && prev[1] == green && prev[2] == blue;
+    if (prev) { prev[0] = red; prev[1] = green; prev[2] = blue; prev += 3; }
+    changed |= !unchanged;
+
+    if (op == OP_RUN && c == lastColor && count < 64) {
+      count++;
+    } else if (unchanged) {
+      if (op == OP_SKIP && count < 64) count++;
+      else begin(OP_SKIP);
+    } else if (op == OP_LIT && c == lastColor) { // repeated color: move the last literal into a run
+      pos -= 3;
+      if (--count == 0) { op = OP_NONE; pos = opPos; }
+      begin(OP_RUN);
+      count = 2;
+      out[pos++] = red; out[pos++] = green; out[pos++] = blue;
+    } else {
+      if (op == OP_LIT && count < 64) count++;
+      else begin(OP_LIT);
+      out[pos++] = red; out[pos++] = green; out[pos++] = blue;
+    }
+    lastColor = c;
+  }
+  flush();
+  return changed ? pos : 0;
+}
+
+// version 3 frame: 'L', 3, flags (bit 0 key frame, bit 1 2D), x, y, w, h (16 bit big endian), records
+static bool sendLiveFrameWs(AsyncWebSocketClient * wsc, live_client_t &lc)
+{
+  const size_t headerLen = 11;
+  bool matrix = false;
+  unsigned width = strip.getLengthTotal(), height = 1;
+#ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) {
+    matrix = true;
+    width  = Segment::maxWidth;
+    height = Segment::maxHeight;
+  }
+#endif
+  if (!width || !height) return true;
+  live_region_t r;
+  r.x = min((unsigned)lc.roi.x, width - 1);
+  r.y = min((unsigned)lc.roi.y, height - 1);
+  r.w = lc.roi.w ? min((unsigned)lc.roi.w, width - r.x) : width - r.x;
+  r.h = lc.roi.h ? min((unsigned)lc.roi.h, height - r.y) : height - r.y;
+  if (r.w * r.h > WS_LIVE_MAX_PIXELS) { // crop rows, then columns
+    r.h = max(1U, WS_LIVE_MAX_PIXELS / r.w);
+    r.w = min((unsigned)r.w, WS_LIVE_MAX_PIXELS);
+  }
+  const size_t pixels = r.w * r.h;
+  const size_t maxLen = headerLen + pixels * 3 + (pixels + 63) / 64;
+
+  if (liveScratchLen < maxLen) {
+    free(liveScratch);
+    liveScratch = static_cast<uint8_t*>(malloc(maxLen));
+    liveScratchLen = liveScratch ? maxLen : 0;
+    if (!liveScratch) return false;
+  }
+  bool key = !lc.prev || !(r == lc.sent); // first frame or new region
+  if (key) {
+    free(lc.prev);
+    lc.prev = static_cast<uint8_t*>(malloc(pixels * 3)); // without memory every frame is a key frame
+    lc.sent = r;
+  }
+  size_t len = encodeLiveFrame(liveScratch + headerLen, lc.prev, key, r, matrix);
+  if (!len) return true; // nothing changed
+  len += headerLen;
+
+  uint8_t *h = liveScratch;
+  h[0] = 'L';
+  h[1] = 3; // version
+  h[2] = (key ? 0x01 : 0) | (matrix ? 0x02 : 0);
+  h[3] = r.x >> 8; h[4] = r.x;
+  h[5] = r.y >> 8; h[6] = r.y;
+  h[7] = r.w >> 8; h[8] = r.w;
+  h[9] = r.h >> 8; h[10] = r.h;
+
+  AsyncWebSocketBuffer wsBuf(len);
+  if (!wsBuf) { // out of memory: lc.prev already holds this frame the client will not get, send a key frame next
+    free(lc.prev);
+    lc.prev = nullptr;
+    return false;
+  }
+  memcpy(wsBuf.data(), liveScratch, len);
+  wsc->binary(std::move(wsBuf));
+  return true;
+}
+
+#ifdef WLED_ENABLE_RT_LATENCY
+static void sendLatencyWs(uint32_t wsClient)
+{
+  AsyncWebSocketClient * wsc = ws.client(wsClient);
+  if (!wsc) {
+    wsLatencyClientId = 0;
+    return;
+  }
+  StaticJsonDocument<512> doc;
+  serializeRealtimeLatency(doc.createNestedObject("rtl"));
+  size_t len = measureJson(doc);
+  AsyncWebSocketBuffer buffer(len);
+  if (!buffer) return;
+  serializeJson(doc, (char *)buffer.data(), len);
+  wsc->text(std::move(buffer));
+}
+#endif
+
 void handleWs()
 {
-  if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
+  if (millis() - wsLastCleanup > WS_LIVE_INTERVAL)
   {
     #ifdef ESP8266
     ws.cleanupClients(3);
     #else
     ws.cleanupClients();
     #endif
-    bool success = true;
-    if (wsLiveClientId) success = sendLiveLedsWs(wsLiveClientId);
-    wsLastLiveTime = millis();
-    if (!success) wsLastLiveTime -= 20; //try again in 20ms if failed due to non-empty WS queue
+    wsLastCleanup = millis();
   }
+
+  bool delta = false;
+  for (live_client_t &lc : liveClients) {
+    if (!lc.id) continue;
+    delta |= lc.delta;
+    if (millis() - lc.lastTime < lc.interval) continue;
+    AsyncWebSocketClient * wsc = ws.client(lc.id);
+    if (!wsc) { removeLiveClient(lc.id); continue; }
+    lc.lastTime = millis();
+    // a client that has not taken the previous frame yet is slow (or its link is): halve its frame rate,
+    // speed up again while it keeps up; delta frames stay correct as they refer to the last frame sent
+    if (wsc->queueLength() > 0) {
+      lc.interval = min(lc.interval * 2, WS_LIVE_INTERVAL_MAX);
+      continue;
+    }
+    bool sent = lc.delta ? sendLiveFrameWs(wsc, lc) : sendLiveLedsWs(wsc);
+    if (!sent) lc.lastTime -= lc.interval / 2; //try again soon if out of memory
+    else if (lc.interval > WS_LIVE_INTERVAL) lc.interval = max(lc.interval - lc.interval / 8, WS_LIVE_INTERVAL);
+  }
+  if (!delta && liveScratch) { // last version 3 client left
+    free(liveScratch);
+    liveScratch = nullptr;
+    liveScratchLen = 0;
+  }
+  #ifdef WLED_ENABLE_RT_LATENCY
+  if (wsLatencyClientId && millis() - wsLastLatencyTime > WS_LATENCY_INTERVAL) {
+    wsLastLatencyTime = millis();
+    if (getRealtimeLatency().count != wsLastLatencyCount) { // only while realtime frames are shown
+      wsLastLatencyCount = getRealtimeLatency().count;
+      sendLatencyWs(wsLatencyClientId);
+    }
+  }
+  #endif
 }
 
 #else
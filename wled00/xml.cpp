@@ -290,8 +290,12 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormCheckbox(settingsScript,PSTR("CR"),strip.cctFromRgb);
     printSetFormValue(settingsScript,PSTR("CB"),Bus::getCCTBlend());
     printSetFormValue(settingsScript,PSTR("FR"),strip.getTargetFps());
+    printSetFormValue(settingsScript,PSTR("KA"),BusManager::getKeepAlive());
+    printSetFormValue(settingsScript,PSTR("NP"),e131OutPriority);
+    printSetFormValue(settingsScript,PSTR("NY"),e131OutSyncUniverse);
     printSetFormValue(settingsScript,PSTR("AW"),Bus::getGlobalAWMode());
     printSetFormCheckbox(settingsScript,PSTR("LD"),useGlobalLedBuffer);
+    printSetFormCheckbox(settingsScript,PSTR("SB"),useSegmentBuffers);
     printSetFormCheckbox(settingsScript,PSTR("PR"),BusManager::hasParallelOutput());  // get it from bus manager not global variable
 
     unsigned sumMa = 0;
@@ -312,6 +316,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       char sp[4] = "SP"; sp[2] = offset+s; sp[3] = 0; //bus clock speed
       char la[4] = "LA"; la[2] = offset+s; la[3] = 0; //LED current
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max per-port PSU current
+      char nu[4] = "NU"; nu[2] = offset+s; nu[3] = 0; //E1.31 start universe
       settingsScript.print(F("addLEDs(1);"));
       uint8_t pins[5];
       int nPins = bus->getPins(pins);
@@ -351,6 +356,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       printSetFormValue(settingsScript,sp,speed);
       printSetFormValue(settingsScript,la,bus->getLEDCurrent());
       printSetFormValue(settingsScript,ma,bus->getMaxCurrent());
+      if (bus->getUniverse()) printSetFormValue(settingsScript,nu,bus->getUniverse());
       sumMa += bus->getMaxCurrent();
     }
     printSetFormValue(settingsScript,PSTR("MA"),BusManager::ablMilliampsMax() ? BusManager::ablMilliampsMax() : sumMa);
@@ -430,11 +436,15 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormCheckbox(settingsScript,PSTR("NL"),nodeListEnabled);
     printSetFormCheckbox(settingsScript,PSTR("NB"),nodeBroadcastEnabled);
 
+    printSetFormCheckbox(settingsScript,PSTR("CK"),clockSync);
+    printSetFormValue(settingsScript,PSTR("CY"),clockSyncPriority);
+
     printSetFormCheckbox(settingsScript,PSTR("RD"),receiveDirect);
     printSetFormCheckbox(settingsScript,PSTR("MO"),useMainSegmentOnly);
     printSetFormCheckbox(settingsScript,PSTR("RLM"),realtimeRespectLedMaps);
     printSetFormValue(settingsScript,PSTR("EP"),e131Port);
     printSetFormCheckbox(settingsScript,PSTR("ES"),e131SkipOutOfSequence);
+    printSetFormValue(settingsScript,PSTR("EF"),e131FrameTimeout);
     printSetFormCheckbox(settingsScript,PSTR("EM"),e131Multicast);
     printSetFormValue(settingsScript,PSTR("EU"),e131Universe);
 #ifdef WLED_ENABLE_DMX